@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+"""Measures how long the compiler takes, and how much memory it needs, to
+instantiate the metaprogramming constructs from the book at increasing sizes.
+
+Every case is a self-contained translation unit in compile_time/ that is
+compiled once for each size, passed in as -DBENCH_N=<n>. The results are
+written to a CSV file with one row per compiler, case and size.
+"""
+
+import argparse
+import csv
+import os
+import shutil
+import subprocess
+import sys
+import time
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+
+# (case name, source file, sizes)
+CASES = [
+   ("tuple_recursive",        "tuple_recursive.cpp",        [10, 100, 500]),
+   ("tuple_flat",             "tuple_flat.cpp",             [10, 100, 500]),
+   ("index_sequence_linear",  "index_sequence_linear.cpp",  [100, 1000, 10000, 100000]),
+   ("index_sequence_log",     "index_sequence_log.cpp",     [100, 1000, 10000, 100000]),
+   ("index_sequence_builtin", "index_sequence_builtin.cpp", [100, 1000, 10000, 100000]),
+   ("manyfold_wrapper",       "manyfold_wrapper.cpp",       [10, 100, 400, 800]),
+   ("typelist",               "typelist.cpp",               [10, 100, 400, 800]),
+]
+
+
+def run_compiler(cmd):
+   """Runs cmd and returns (exit code, wall seconds, peak RSS in KiB, stderr).
+
+   The peak RSS comes from the rusage of the child process, which is only
+   available where os.wait4 exists; elsewhere it is None.
+   """
+   start = time.perf_counter()
+   proc = subprocess.Popen(cmd, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE)
+   stderr = proc.stderr.read()
+   if hasattr(os, "wait4"):
+      _, status, usage = os.wait4(proc.pid, 0)
+      elapsed = time.perf_counter() - start
+      proc.returncode = os.waitstatus_to_exitcode(status)
+      # ru_maxrss is in KiB on Linux and in bytes on macOS
+      rss = usage.ru_maxrss // 1024 if sys.platform == "darwin" else usage.ru_maxrss
+   else:
+      proc.wait()
+      elapsed = time.perf_counter() - start
+      rss = None
+   return proc.returncode, elapsed, rss, stderr.decode(errors="replace")
+
+
+def compiler_version(compiler):
+   try:
+      out = subprocess.run([compiler, "--version"], stdout=subprocess.PIPE,
+                           stderr=subprocess.DEVNULL).stdout.decode(errors="replace")
+      return out.splitlines()[0].strip() if out else ""
+   except OSError:
+      return ""
+
+
+def first_error(stderr):
+   lines = stderr.splitlines()
+   line = next((l for l in lines if "error" in l), lines[0] if lines else "")
+   return line if len(line) <= 160 else line[:157] + "..."
+
+
+def default_compilers():
+   found = [shutil.which(c) for c in ("g++", "clang++")]
+   return [c for c in found if c] or [os.environ.get("CXX", "c++")]
+
+
+def main():
+   parser = argparse.ArgumentParser(description=__doc__)
+   parser.add_argument("--compiler", action="append",
+                       help="compiler to measure; may be repeated "
+                            "(default: g++ and clang++ if found)")
+   parser.add_argument("--output", default="compile_bench.csv")
+   parser.add_argument("--repeat", type=int, default=3,
+                       help="compilations per size; the fastest one is kept")
+   parser.add_argument("--case", action="append",
+                       help="only run the named case; may be repeated")
+   parser.add_argument("--flag", action="append", default=[],
+                       help="extra flag passed to the compiler")
+   args = parser.parse_args()
+
+   compilers = args.compiler or default_compilers()
+   cases = [c for c in CASES if not args.case or c[0] in args.case]
+
+   rows = []
+   for compiler in compilers:
+      version = compiler_version(compiler)
+      print("== {} ({})".format(compiler, version))
+      for name, file, sizes in cases:
+         source = os.path.join(HERE, "compile_time", file)
+         for n in sizes:
+            cmd = [compiler, "-std=c++2a", "-fsyntax-only",
+                   "-DBENCH_N={}".format(n)] + args.flag + [source]
+            ok, best, peak, error = True, None, None, ""
+            for _ in range(args.repeat):
+               code, elapsed, rss, error = run_compiler(cmd)
+               ok = code == 0
+               if not ok:
+                  break
+               best = elapsed if best is None else min(best, elapsed)
+               if rss is not None:
+                  peak = rss if peak is None else max(peak, rss)
+            status = "ok" if ok else "failed"
+            seconds = "{:.3f}".format(best) if ok else ""
+            rss_kib = str(peak) if ok and peak is not None else ""
+            print("{:<24} N={:<7} {:>9} {:>10} {}".format(
+               name, n, seconds + "s" if ok else "-",
+               rss_kib + "KiB" if rss_kib else "-", status))
+            if not ok:
+               print("   " + first_error(error), file=sys.stderr)
+            rows.append([os.path.basename(compiler), version, name, n,
+                         seconds, rss_kib, status])
+
+   with open(args.output, "w", newline="") as f:
+      writer = csv.writer(f)
+      writer.writerow(["compiler", "version", "case", "n",
+                       "seconds", "peak_rss_kib", "status"])
+      writer.writerows(rows)
+   print("results written to " + args.output)
+
+
+if __name__ == "__main__":
+   main()
@@ -0,0 +1,21 @@
+// Builds std::make_index_sequence<BENCH_N>, which the standard library
+// implements with a compiler builtin.
+
+#include <cstddef>
+#include <utility>
+
+#ifndef BENCH_N
+#define BENCH_N 10
+#endif
+
+template <std::size_t... Is>
+constexpr std::size_t count(std::index_sequence<Is...>)
+{
+   return sizeof...(Is);
+}
+
+static_assert(count(std::make_index_sequence<BENCH_N>{}) == BENCH_N);
+
+int main()
+{
+}
@@ -0,0 +1,37 @@
+// Builds make_index_sequence<BENCH_N> with the original one-element-per-step
+// recursion from n317.
+
+#include <cstddef>
+
+#ifndef BENCH_N
+#define BENCH_N 10
+#endif
+
+template <typename T, T... Ints>
+struct integer_sequence
+{
+};
+
+template <std::size_t... Ints>
+using index_sequence = integer_sequence<std::size_t, Ints...>;
+
+template <typename T, std::size_t N, T... Is>
+struct make_integer_sequence : make_integer_sequence<T, N - 1, N - 1, Is...> {};
+
+template <typename T, T... Is>
+struct make_integer_sequence<T, 0, Is...> : integer_sequence<T, Is...> {};
+
+template <std::size_t N>
+using make_index_sequence = make_integer_sequence<std::size_t, N>;
+
+template <std::size_t... Is>
+constexpr std::size_t count(index_sequence<Is...>)
+{
+   return sizeof...(Is);
+}
+
+static_assert(count(make_index_sequence<BENCH_N>{}) == BENCH_N);
+
+int main()
+{
+}
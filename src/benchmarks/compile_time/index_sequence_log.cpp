@@ -0,0 +1,60 @@
+// Builds make_index_sequence<BENCH_N> by concatenating two halves, as in n317,
+// which keeps the instantiation depth at log2(N).
+
+#include <cstddef>
+
+#ifndef BENCH_N
+#define BENCH_N 10
+#endif
+
+template <typename T, T... Ints>
+struct integer_sequence
+{
+};
+
+template <std::size_t... Ints>
+using index_sequence = integer_sequence<std::size_t, Ints...>;
+
+template <typename S1, typename S2>
+struct concat_sequence;
+
+template <typename T, T... I1, T... I2>
+struct concat_sequence<integer_sequence<T, I1...>, integer_sequence<T, I2...>>
+{
+   using type = integer_sequence<T, I1..., (sizeof...(I1) + I2)...>;
+};
+
+template <typename T, std::size_t N>
+struct make_integer_sequence_impl
+{
+   using type = typename concat_sequence<
+      typename make_integer_sequence_impl<T, N / 2>::type,
+      typename make_integer_sequence_impl<T, N - N / 2>::type>::type;
+};
+
+template <typename T>
+struct make_integer_sequence_impl<T, 0>
+{
+   using type = integer_sequence<T>;
+};
+
+template <typename T>
+struct make_integer_sequence_impl<T, 1>
+{
+   using type = integer_sequence<T, 0>;
+};
+
+template <std::size_t N>
+using make_index_sequence = typename make_integer_sequence_impl<std::size_t, N>::type;
+
+template <std::size_t... Is>
+constexpr std::size_t count(index_sequence<Is...>)
+{
+   return sizeof...(Is);
+}
+
+static_assert(count(make_index_sequence<BENCH_N>{}) == BENCH_N);
+
+int main()
+{
+}
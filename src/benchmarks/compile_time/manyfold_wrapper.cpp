@@ -0,0 +1,26 @@
+// Instantiates manyfold_wrapper<BENCH_N> from n410, which nests
+// wrapper<...> BENCH_N times, one recursive instantiation per level.
+
+#ifndef BENCH_N
+#define BENCH_N 10
+#endif
+
+template <typename T>
+struct wrapper {};
+
+template <int N>
+struct manyfold_wrapper
+{
+   using value_type = wrapper<typename manyfold_wrapper<N - 1>::value_type>;
+};
+
+template <>
+struct manyfold_wrapper<0>
+{
+   using value_type = unsigned int;
+};
+
+int main()
+{
+   [[maybe_unused]] manyfold_wrapper<BENCH_N>::value_type w;
+}
@@ -0,0 +1,52 @@
+// Instantiates the flat tuple from n319 with BENCH_N elements
+// and reads the last element through get<N - 1>.
+
+#include <cstddef>
+#include <utility>
+
+#ifndef BENCH_N
+#define BENCH_N 10
+#endif
+
+template <std::size_t I, typename T>
+struct tuple_leaf
+{
+   T value{};
+};
+
+template <typename Seq, typename... Ts>
+struct tuple_impl;
+
+template <std::size_t... Is, typename... Ts>
+struct tuple_impl<std::index_sequence<Is...>, Ts...> : tuple_leaf<Is, Ts>...
+{
+};
+
+template <typename... Ts>
+struct tuple : tuple_impl<std::index_sequence_for<Ts...>, Ts...>
+{
+};
+
+template <std::size_t N, typename T>
+T& get_leaf(tuple_leaf<N, T>& leaf)
+{
+   return leaf.value;
+}
+
+template <std::size_t N, typename... Ts>
+auto& get(tuple<Ts...>& t)
+{
+   return get_leaf<N>(t);
+}
+
+template <std::size_t I>
+struct element { int value; };
+
+template <std::size_t... Is>
+auto make(std::index_sequence<Is...>) -> tuple<element<Is>...>;
+
+int main()
+{
+   decltype(make(std::make_index_sequence<BENCH_N>{})) t;
+   return get<BENCH_N - 1>(t).value + get<BENCH_N / 2>(t).value;
+}
@@ -0,0 +1,71 @@
+// Instantiates the recursive tuple from n313 with BENCH_N elements
+// and reads the last element through get<N - 1>.
+
+#include <cstddef>
+#include <utility>
+
+#ifndef BENCH_N
+#define BENCH_N 10
+#endif
+
+template <typename T, typename... Ts>
+struct tuple
+{
+   tuple() = default;
+
+   T value{};
+   tuple<Ts...> rest;
+};
+
+template <typename T>
+struct tuple<T>
+{
+   T value{};
+};
+
+template <std::size_t N, typename T, typename... Ts>
+struct nth_type : nth_type<N - 1, Ts...> {};
+
+template <typename T, typename... Ts>
+struct nth_type<0, T, Ts...>
+{
+   using value_type = T;
+};
+
+template <std::size_t N>
+struct getter
+{
+   template <typename... Ts>
+   static typename nth_type<N, Ts...>::value_type& get(tuple<Ts...>& t)
+   {
+      return getter<N - 1>::get(t.rest);
+   }
+};
+
+template <>
+struct getter<0>
+{
+   template <typename T, typename... Ts>
+   static T& get(tuple<T, Ts...>& t)
+   {
+      return t.value;
+   }
+};
+
+template <std::size_t N, typename... Ts>
+typename nth_type<N, Ts...>::value_type& get(tuple<Ts...>& t)
+{
+   return getter<N>::get(t);
+}
+
+template <std::size_t I>
+struct element { int value; };
+
+template <std::size_t... Is>
+auto make(std::index_sequence<Is...>) -> tuple<element<Is>...>;
+
+int main()
+{
+   decltype(make(std::make_index_sequence<BENCH_N>{})) t;
+   return get<BENCH_N - 1>(t).value + get<BENCH_N / 2>(t).value;
+}
@@ -0,0 +1,106 @@
+// Runs the typelist operations from n714 (length, back, pop_back, at) on a
+// typelist of BENCH_N distinct types.
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#ifndef BENCH_N
+#define BENCH_N 10
+#endif
+
+template <typename... Ts>
+struct typelist {};
+
+struct empty_type {};
+
+namespace detail
+{
+   template <typename TL>
+   struct length;
+
+   template <template <typename...> typename TL, typename... Ts>
+   struct length<TL<Ts...>>
+   {
+      using type = std::integral_constant<std::size_t, sizeof...(Ts)>;
+   };
+
+   template <typename TL>
+   struct back_type;
+
+   template <template <typename...> typename TL, typename T, typename... Ts>
+   struct back_type<TL<T, Ts...>>
+   {
+      using type = typename back_type<TL<Ts...>>::type;
+   };
+
+   template <template <typename...> typename TL, typename T>
+   struct back_type<TL<T>>
+   {
+      using type = T;
+   };
+
+   template <std::ptrdiff_t N, typename R, typename TL>
+   struct pop_back_type;
+
+   template <std::ptrdiff_t N, typename... Ts, typename U, typename... Us>
+   struct pop_back_type<N, typelist<Ts...>, typelist<U, Us...>>
+   {
+      using type = typename pop_back_type<N - 1, typelist<Ts..., U>, typelist<Us...>>::type;
+   };
+
+   template <typename... Ts, typename... Us>
+   struct pop_back_type<0, typelist<Ts...>, typelist<Us...>>
+   {
+      using type = typelist<Ts...>;
+   };
+
+   template <typename... Ts, typename U, typename... Us>
+   struct pop_back_type<0, typelist<Ts...>, typelist<U, Us...>>
+   {
+      using type = typelist<Ts...>;
+   };
+
+   template <std::size_t I, std::size_t N, typename TL>
+   struct at_type;
+
+   template <std::size_t I, std::size_t N, template <typename...> typename TL, typename T, typename... Ts>
+   struct at_type<I, N, TL<T, Ts...>>
+   {
+      using type = std::conditional_t<I == N, T, typename at_type<I, N + 1, TL<Ts...>>::type>;
+   };
+
+   template <std::size_t I, std::size_t N>
+   struct at_type<I, N, typelist<>>
+   {
+      using type = empty_type;
+   };
+}
+
+template <typename TL>
+constexpr std::size_t length_v = detail::length<TL>::type::value;
+
+template <typename TL>
+using back_t = typename detail::back_type<TL>::type;
+
+template <typename TL>
+using pop_back_t = typename detail::pop_back_type<static_cast<std::ptrdiff_t>(length_v<TL>) - 1, typelist<>, TL>::type;
+
+template <std::size_t I, typename TL>
+using at_t = typename detail::at_type<I, 0, TL>::type;
+
+template <std::size_t I>
+struct element {};
+
+template <std::size_t... Is>
+auto make(std::index_sequence<Is...>) -> typelist<element<Is>...>;
+
+using list = decltype(make(std::make_index_sequence<BENCH_N>{}));
+
+static_assert(std::is_same_v<back_t<list>, element<BENCH_N - 1>>);
+static_assert(length_v<pop_back_t<list>> == BENCH_N - 1);
+static_assert(std::is_same_v<at_t<BENCH_N / 2, list>, element<BENCH_N / 2>>);
+
+int main()
+{
+}
@@ -2,6 +2,35 @@
 #include <array>
 #include <functional>
 #include <tuple>
+#include <vector>
+#include <utility>
+#include <chrono>
+#include <version>
+#ifdef __cpp_lib_format
+#include <format>
+#endif
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <queue>
+#include <latch>
+#include <optional>
+#include <exception>
+#include <atomic>
+#include <span>
+#include <cmath>
+#include <random>
+#include <iomanip>
+#include <limits>
 
 namespace n301
 {
@@ -193,14 +222,15 @@ namespace n312
       return (a + b) / c;
    }
 
-   template<typename, typename>
+   template<typename, typename, template<typename> class Function = std::function>
    struct func_pair;
 
-   template<typename R1, typename... A1, typename R2, typename... A2>
-   struct func_pair<R1(A1...), R2(A2...)>
+   template<typename R1, typename... A1, typename R2, typename... A2,
+            template<typename> class Function>
+   struct func_pair<R1(A1...), R2(A2...), Function>
    {
-      std::function<R1(A1...)> f;
-      std::function<R2(A2...)> g;
+      Function<R1(A1...)> f;
+      Function<R2(A2...)> g;
    };
 }
 
@@ -348,16 +378,45 @@ namespace n317
    template<typename T, T... Ints>
    struct integer_sequence
    {
+      static constexpr std::size_t size() noexcept { return sizeof...(Ints); }
    };
 
    template<std::size_t... Ints>
    using index_sequence = integer_sequence<std::size_t, Ints...>;
 
-   template<typename T, std::size_t N, T... Is>
-   struct make_integer_sequence : make_integer_sequence<T, N - 1, N - 1, Is...> {};
+   template<typename S1, typename S2>
+   struct concat_sequence;
+
+   template<typename T, T... I1, T... I2>
+   struct concat_sequence<integer_sequence<T, I1...>, integer_sequence<T, I2...>>
+   {
+      using type = integer_sequence<T, I1..., (sizeof...(I1) + I2)...>;
+   };
+
+   // [0, N) is built from two halves [0, N/2) and [0, N - N/2), the second
+   // shifted by N/2, so the instantiation depth is log2(N) instead of N
+   template<typename T, std::size_t N>
+   struct make_integer_sequence_impl
+   {
+      using type = typename concat_sequence<
+         typename make_integer_sequence_impl<T, N / 2>::type,
+         typename make_integer_sequence_impl<T, N - N / 2>::type>::type;
+   };
+
+   template<typename T>
+   struct make_integer_sequence_impl<T, 0>
+   {
+      using type = integer_sequence<T>;
+   };
+
+   template<typename T>
+   struct make_integer_sequence_impl<T, 1>
+   {
+      using type = integer_sequence<T, 0>;
+   };
 
-   template<typename T, T... Is>
-   struct make_integer_sequence<T, 0, Is...> : integer_sequence<T, Is...> {};
+   template<typename T, std::size_t N>
+   using make_integer_sequence = typename make_integer_sequence_impl<T, N>::type;
 
    template<std::size_t N>
    using make_index_sequence = make_integer_sequence<std::size_t, N>;
@@ -497,204 +556,2103 @@ namespace n318
    };
 }
 
-int main()
+namespace timing
+{
+   // milliseconds that f() takes
+   template <typename F>
+   double milliseconds(F&& f)
+   {
+      auto const start = std::chrono::steady_clock::now();
+      std::forward<F>(f)();
+      auto const end = std::chrono::steady_clock::now();
+      return std::chrono::duration<double, std::milli>(end - start).count();
+   }
+}
+
+namespace n319
 {
+   template <std::size_t I, typename T>
+   struct tuple_leaf
    {
-      using namespace n301;
+      T value;
+   };
 
-      std::cout << "min(42, 7)=" << min(2, 42, 7) << '\n';
-      std::cout << "min(1,5,3,-4,9)=" << min(5, 1, 5, 3, -4, 9) << '\n';
-   }
+   template <typename Seq, typename... Ts>
+   struct tuple_impl;
 
+   template <std::size_t... Is, typename... Ts>
+   struct tuple_impl<std::index_sequence<Is...>, Ts...>
+      : tuple_leaf<Is, Ts>...
    {
-      using namespace n302;
+      tuple_impl() = default;
 
-      std::cout << "min(42.0, 7.5)=" << min<double>(2, 42.0, 7.5) << '\n';
-      std::cout << "min(1,5,3,-4,9)=" << min<int>(5, 1, 5, 3, -4, 9) << '\n';
-   }
+      // for an empty pack this would redeclare the default constructor
+      tuple_impl(Ts const &... ts) requires (sizeof...(Ts) > 0)
+         : tuple_leaf<Is, Ts>{ ts }...
+      {
+      }
+   };
 
+   template <typename... Ts>
+   struct tuple : tuple_impl<std::index_sequence_for<Ts...>, Ts...>
    {
-      using namespace n303;
+      using tuple_impl<std::index_sequence_for<Ts...>, Ts...>::tuple_impl;
 
-      std::cout << "min(42.0, 7.5)=" << min(42.0, 7.5) << '\n';
-      std::cout << "min(1,5,3,-4,9)=" << min(1, 5, 3, -4, 9) << '\n';
-   }
+      constexpr int size() const { return sizeof...(Ts); }
+   };
 
+   // T is deduced from the unique base tuple_leaf<N, T>,
+   // so no recursive nth_type/getter is instantiated
+   template <std::size_t N, typename T>
+   T& get_leaf(tuple_leaf<N, T>& leaf)
    {
-      using namespace n304;
+      return leaf.value;
+   }
 
-      std::cout << "min(42, 7)=" << min(42, 7) << '\n';
-      std::cout << "min(1,5,3,-4,9)=" << min(1, 5, 3, -4, 9) << '\n';
+   template <std::size_t N, typename... Ts>
+   auto& get(tuple<Ts...>& t)
+   {
+      static_assert(N < sizeof...(Ts), "index out of bounds");
+      return get_leaf<N>(t);
    }
 
+   template <typename T, std::size_t>
+   using repeat = T;
+
+   template <typename T, typename Seq>
+   struct make_uniform_tuple;
+
+   template <typename T, std::size_t... Is>
+   struct make_uniform_tuple<T, std::index_sequence<Is...>>
    {
-      using namespace n305;
+      using type = tuple<repeat<T, Is>...>;
+   };
 
-      min(1, 5, 3, -4, 9);
-   }
+   template <typename T, std::size_t N>
+   using uniform_tuple = typename make_uniform_tuple<T, std::make_index_sequence<N>>::type;
+}
 
+namespace n320
+{
+   // storage order: declared indexes stably sorted by decreasing alignment
+   template <typename... Ts>
+   constexpr auto alignment_order()
    {
-      using namespace n306;
+      std::array<std::size_t, sizeof...(Ts)> order{};
+      if constexpr (sizeof...(Ts) > 0)
+      {
+         constexpr std::size_t aligns[] = { alignof(Ts)... };
+         for (std::size_t i = 0; i < order.size(); ++i)
+         {
+            std::size_t j = i;
+            while (j > 0 && aligns[order[j - 1]] < aligns[i])
+            {
+               order[j] = order[j - 1];
+               --j;
+            }
+            order[j] = i;
+         }
+      }
+      return order;
+   }
 
-      std::cout << sum(1, 2, 3, 4, 5) << '\n';
-      std::cout << sum(1) << '\n';
+   template <std::size_t N>
+   constexpr auto invert(std::array<std::size_t, N> const& order)
+   {
+      std::array<std::size_t, N> position{};
+      for (std::size_t i = 0; i < N; ++i)
+         position[order[i]] = i;
+      return position;
    }
 
+   template <typename... Ts>
+   struct tuple
    {
-      using namespace n307;
+      static constexpr auto order = alignment_order<Ts...>();
+      static constexpr auto position = invert(order);
 
-      std::cout << sum(1, 2, 3, 4, 5) << '\n';
-      std::cout << sum(1) << '\n';
+      tuple() = default;
+
+      tuple(Ts const &... ts) requires (sizeof...(Ts) > 0)
+         : storage(make_storage(std::index_sequence_for<Ts...>{}, ts...))
+      {
+      }
+
+      constexpr int size() const { return sizeof...(Ts); }
+
+   private:
+      template <std::size_t... Is>
+      static auto storage_type(std::index_sequence<Is...>)
+         -> n319::tuple<std::tuple_element_t<order[Is], std::tuple<Ts...>>...>;
+
+      template <std::size_t... Is>
+      static auto make_storage(std::index_sequence<Is...>, Ts const &... ts)
+      {
+         auto args = std::forward_as_tuple(ts...);
+         return decltype(storage_type(std::index_sequence<Is...>{}))(
+            std::get<order[Is]>(args)...);
+      }
+
+      using storage_t = decltype(storage_type(std::index_sequence_for<Ts...>{}));
+
+      storage_t storage;
+
+      template <std::size_t N, typename... Us>
+      friend auto& get(tuple<Us...>& t);
+   };
+
+   template <std::size_t N, typename... Ts>
+   auto& get(tuple<Ts...>& t)
+   {
+      static_assert(N < sizeof...(Ts), "index out of bounds");
+      return n319::get<tuple<Ts...>::position[N]>(t.storage);
    }
 
+   template <typename Tuple>
+   void scan(std::size_t count)
    {
-      using namespace n308;
+      std::vector<Tuple> v(count, Tuple('a', 1.5, 'b', 2));
 
-      auto sizes = get_type_sizes<short, int, long, long long>();
-      for (auto const& s : sizes)
-         std::cout << s << '\n';
+      double total = 0;
+      double const ms = timing::milliseconds([&] {
+         for (auto& t : v)
+            total += get<1>(t) + get<3>(t);
+      });
+
+      std::cout << "   " << sizeof(Tuple) << " bytes, " << ms << " ms, total=" << total << '\n';
    }
+}
+
+namespace n321
+{
+   constexpr std::size_t cache_line_size = 64;
 
+   struct field_layout
    {
-      using namespace n310;
-      multipacks<int>(1, 2, 3, 4, 5, 6);                    // 1,5
-      multipacks<int, int, int>(1, 2, 3, 4, 5, 6);          // 3,3
-      multipacks<int, int, int, int>(1, 2, 3, 4, 5, 6);     // 4,2
-      multipacks<int, int, int, int, int, int>(1, 2, 3, 4, 5, 6); // 6,0
+      std::size_t size;
+      std::size_t alignment;
+      std::size_t offset;
+      std::size_t padding;    // bytes inserted before this field
+      bool        straddles;  // crosses a cache line boundary
+   };
 
-      multipacks<int, int>(1, 2, 4.0, 5.0, 6.0);            // 2,3
-      multipacks<int, int, int>(1, 2, 3, 4.0, 5.0, 6.0);    // 3,3
+   template<typename... Ts>
+   constexpr auto get_type_layouts()
+   {
+      return std::array<field_layout, sizeof...(Ts)>{
+         field_layout{ sizeof(Ts), alignof(Ts), 0, 0, false }...};
    }
 
+   // lays out Ts in declaration order the way an aggregate with these
+   // members and at least the given alignment is laid out; the cache line
+   // figures are the worst case over every start address that the
+   // alignment allows, so they hold for objects in arrays and on the heap
+   template<std::size_t Alignment, typename... Ts>
+   struct aligned_layout
+   {
+      static constexpr std::size_t alignment = std::max({ Alignment, alignof(Ts)... });
+
+      static constexpr auto fields = []{
+         auto fields = get_type_layouts<Ts...>();
+         std::size_t offset = 0;
+         for (auto& f : fields)
+         {
+            f.padding = (f.alignment - offset % f.alignment) % f.alignment;
+            f.offset = offset + f.padding;
+            f.straddles = false;
+            for (std::size_t start = 0; start < cache_line_size; start += alignment)
+            {
+               std::size_t first = start + f.offset;
+               f.straddles = f.straddles || (f.size > 0 &&
+                  first / cache_line_size != (first + f.size - 1) / cache_line_size);
+            }
+            offset = f.offset + f.size;
+         }
+         return fields;
+      }();
+
+      static constexpr std::size_t size = []{
+         std::size_t end = fields.empty() ? 0 : fields.back().offset + fields.back().size;
+         return std::max(std::size_t{1}, (end + alignment - 1) / alignment * alignment);
+      }();
+
+      static constexpr std::size_t padding = size - (0 + ... + sizeof(Ts));
+
+      static constexpr std::size_t straddling_fields = []{
+         std::size_t count = 0;
+         for (auto const& f : fields)
+            count += f.straddles;
+         return count;
+      }();
+
+      static constexpr std::size_t cache_lines = []{
+         std::size_t lines = 0;
+         for (std::size_t start = 0; start < cache_line_size; start += alignment)
+            lines = std::max(lines, (start + size - 1) / cache_line_size + 1);
+         return lines;
+      }();
+
+      static constexpr bool fits_in_cache_line = cache_lines == 1;
+   };
+
+   template<typename... Ts>
+   using layout = aligned_layout<1, Ts...>;
+
+   template <typename T>
+   struct layout_of;
+
+   template <typename... Ts>
+   struct layout_of<n319::tuple<Ts...>> : layout<Ts...>
    {
-      using namespace n311;
-      //multipacks<int>(1, 2, 3, 4, 5, 6);                    // error
-      multipacks<int, int, int>(1, 2, 3, 4, 5, 6);          // OK
-      //multipacks<int, int, int, int>(1, 2, 3, 4, 5, 6);     // error
-      //multipacks<int, int, int, int, int, int>(1, 2, 3, 4, 5, 6); // error
+   };
 
-      //multipacks<int, int>(1, 2, 4.0, 5.0, 6.0);            // error
-      multipacks<int, int, int>(1, 2, 3, 4.0, 5.0, 6.0);    // OK
-   }
+   // true if the field list has the size and alignment of T; a list with
+   // the right types in the wrong order can still match, so check the
+   // offsets as well with has_offsets when the members are known
+   template <typename T, typename L>
+   constexpr bool describes = sizeof(T) == L::size && alignof(T) == L::alignment;
 
+   template <typename L, typename... Offsets>
+   constexpr bool has_offsets(Offsets... offsets)
    {
-      using namespace n312;
+      static_assert(sizeof...(Offsets) == L::fields.size(), "one offset per field");
+      std::size_t i = 0;
+      return (... && (L::fields[i++].offset == offsets));
+   }
 
-      func_pair<bool(int, int), double(int, int, double)> funcs{ twice_as, sum_and_div };
-      funcs.f(42, 12);
-      funcs.g(42, 12, 10.0);
+   template <typename L>
+   void print_layout(char const* name)
+   {
+      std::cout << name << ": size=" << L::size
+                << " align=" << L::alignment
+                << " padding=" << L::padding
+                << " cache_lines=" << L::cache_lines << '\n';
+      for (std::size_t i = 0; i < L::fields.size(); ++i)
+      {
+         auto const& f = L::fields[i];
+         std::cout << "   [" << i << "] offset=" << f.offset
+                   << " size=" << f.size
+                   << " align=" << f.alignment
+                   << " padding=" << f.padding
+                   << (f.straddles ? " straddles cache line" : "") << '\n';
+      }
    }
 
+   // only 8-aligned on its own, hot_entry could start anywhere but at the
+   // beginning of a cache line and straddle two of them
+   struct alignas(cache_line_size) hot_entry
    {
-      using namespace n313;
+      char   flag;
+      double value;
+      int    count;
+      char   tag[40];
+   };
 
-      tuple<int> one(42);
-      tuple<int, double> two(42, 42.0);
-      tuple<int, double, char> three(42, 42.0, 'a');
+   using hot_entry_layout = aligned_layout<cache_line_size, char, double, int, char[40]>;
 
-      std::cout << one.value << '\n';
-      std::cout << two.value << ',' 
-                << two.rest.value << '\n';
-      std::cout << three.value << ',' 
-                << three.rest.value << ','
-                << three.rest.rest.value << '\n';
+   static_assert(describes<hot_entry, hot_entry_layout>);
+   static_assert(has_offsets<hot_entry_layout>(offsetof(hot_entry, flag),
+                                               offsetof(hot_entry, value),
+                                               offsetof(hot_entry, count),
+                                               offsetof(hot_entry, tag)));
+   static_assert(hot_entry_layout::fits_in_cache_line,
+                 "hot_entry must fit in one cache line");
+   static_assert(hot_entry_layout::straddling_fields == 0);
 
-      std::cout << get<0>(one) << '\n';
-      std::cout << get<0>(two) << ','
-                << get<1>(two) << '\n';
-      std::cout << get<0>(three) << ','
-                << get<1>(three) << ','
-                << get<2>(three) << '\n';
-   }
+   static_assert(describes<n319::tuple<char, double, char, int>,
+                           layout_of<n319::tuple<char, double, char, int>>>);
+}
+
+namespace n322
+{
+   // like std::function, but the callable is always stored in the object
+   // itself; callables larger than Capacity are rejected at compile time
+   template <typename Signature, std::size_t Capacity = 32>
+   class inplace_function;
 
+   template <typename R, typename... A, std::size_t Capacity>
+   class inplace_function<R(A...), Capacity>
    {
-      using namespace n314;
+   public:
+      inplace_function() = default;
 
-      // std::cout << sum() << '\n'; // error
-      std::cout << sum(1) << '\n';
-      std::cout << sum(1, 2) << '\n';
-      std::cout << sum(1, 2, 3, 4, 5) << '\n';
+      template <typename F>
+         requires (!std::is_same_v<std::decay_t<F>, inplace_function> &&
+                   std::is_invocable_r_v<R, std::decay_t<F>&, A...>)
+      inplace_function(F&& f)
+      {
+         using T = std::decay_t<F>;
+         static_assert(sizeof(T) <= Capacity, "callable does not fit in the buffer");
+         static_assert(alignof(T) <= alignof(std::max_align_t), "callable is over-aligned");
+
+         ::new (static_cast<void*>(buffer)) T(std::forward<F>(f));
+         invoker = [](void* obj, A&&... args) -> R {
+            return std::invoke(*static_cast<T*>(obj), std::forward<A>(args)...);
+         };
+         manager = [](operation op, void* dst, void* src) {
+            switch (op)
+            {
+            case operation::copy:    ::new (dst) T(*static_cast<T const*>(src)); break;
+            case operation::move:    ::new (dst) T(std::move(*static_cast<T*>(src))); break;
+            case operation::destroy: static_cast<T*>(dst)->~T(); break;
+            }
+         };
+      }
 
-      std::cout << sum_from_zero() << '\n';
-      std::cout << sum_from_zero(1, 2, 3) << '\n';
-   }
+      inplace_function(inplace_function const& other)
+         : invoker(other.invoker), manager(other.manager)
+      {
+         if (manager)
+            manager(operation::copy, buffer, const_cast<unsigned char*>(other.buffer));
+      }
+
+      inplace_function(inplace_function&& other) noexcept
+         : invoker(other.invoker), manager(other.manager)
+      {
+         if (manager)
+            manager(operation::move, buffer, other.buffer);
+      }
+
+      inplace_function& operator=(inplace_function other) noexcept
+      {
+         reset();
+         invoker = other.invoker;
+         manager = other.manager;
+         if (manager)
+            manager(operation::move, buffer, other.buffer);
+         return *this;
+      }
+
+      ~inplace_function() { reset(); }
+
+      R operator()(A... args) const
+      {
+         return invoker(buffer, std::forward<A>(args)...);
+      }
+
+      explicit operator bool() const noexcept { return invoker != nullptr; }
+
+   private:
+      enum class operation { copy, move, destroy };
+
+      void reset() noexcept
+      {
+         if (manager)
+            manager(operation::destroy, buffer, nullptr);
+         invoker = nullptr;
+         manager = nullptr;
+      }
+
+      alignas(std::max_align_t) mutable unsigned char buffer[Capacity];
+      R (*invoker)(void*, A&&...) = nullptr;
+      void (*manager)(operation, void*, void*) = nullptr;
+   };
 
+   // non-owning reference to a callable; the callable must outlive it
+   template <typename Signature>
+   class function_ref;
+
+   template <typename R, typename... A>
+   class function_ref<R(A...)>
    {
-      using namespace n315;
+   public:
+      template <typename F>
+         requires (!std::is_same_v<std::decay_t<F>, function_ref> &&
+                   std::is_invocable_r_v<R, F&, A...>)
+      function_ref(F&& f) noexcept
+      {
+         using T = std::remove_reference_t<F>;
+         if constexpr (std::is_function_v<T>)
+         {
+            callable.fn = reinterpret_cast<void (*)()>(&f);
+            invoker = [](target t, A&&... args) -> R {
+               return reinterpret_cast<T*>(t.fn)(std::forward<A>(args)...);
+            };
+         }
+         else if constexpr (std::is_pointer_v<std::remove_cv_t<T>> &&
+                            std::is_function_v<std::remove_pointer_t<std::remove_cv_t<T>>>)
+         {
+            // f may be a temporary pointer, so keep its value, not its address
+            using P = std::remove_cv_t<T>;
+            callable.fn = reinterpret_cast<void (*)()>(f);
+            invoker = [](target t, A&&... args) -> R {
+               return reinterpret_cast<P>(t.fn)(std::forward<A>(args)...);
+            };
+         }
+         else
+         {
+            callable.obj = const_cast<void*>(static_cast<void const*>(std::addressof(f)));
+            invoker = [](target t, A&&... args) -> R {
+               return std::invoke(*static_cast<T*>(t.obj), std::forward<A>(args)...);
+            };
+         }
+      }
 
-      printl('d', 'o', 'g');  // dog
-      printr('d', 'o', 'g');  // dog
-      print('d', 'o', 'g');  // dog
+      R operator()(A... args) const
+      {
+         return invoker(callable, std::forward<A>(args)...);
+      }
+
+   private:
+      union target
+      {
+         void* obj;
+         void (*fn)();
+      };
+
+      target callable;
+      R (*invoker)(target, A&&...);
+   };
+
+   template <template<typename> class Function>
+   void construct_and_invoke(char const* name, int count)
+   {
+      double total = 0;
+      double const ms = timing::milliseconds([&] {
+         for (int i = 0; i < count; ++i)
+         {
+            double a = i, b = 2.0, c = 0.5;
+            auto lambda = [a, b, c](double x) { return a * x + b * c; };
+            Function<double(double)> f = lambda;
+            total += f(1.0);
+         }
+      });
+
+      std::cout << name << ": " << ms << " ms, total=" << total << '\n';
    }
+}
 
-   {
-      using namespace n315;
+namespace n323
+{
+   template <typename Op, typename T>
+   constexpr auto reduce(Op const& op, T const& value);
 
-      std::vector<int> v;
-      push_back_many(v, 1, 2, 3, 4, 5);
+   template <typename Op, typename T1, typename T2, typename... Ts>
+   constexpr auto reduce(Op const& op, T1 const& a, T2 const& b, Ts const&... rest);
+
+   // one level of the reduction: neighbours are combined in pairs, and an
+   // odd last argument is passed on as it is
+   template <typename Op, typename Tuple, std::size_t... Is>
+   constexpr auto pair_up(Op const& op, Tuple const& t, std::index_sequence<Is...>)
+   {
+      constexpr std::size_t N = std::tuple_size_v<Tuple>;
+      if constexpr (N % 2 == 0)
+         return reduce(op, op(std::get<2 * Is>(t), std::get<2 * Is + 1>(t))...);
+      else
+         return reduce(op, op(std::get<2 * Is>(t), std::get<2 * Is + 1>(t))..., std::get<N - 1>(t));
    }
 
+   template <typename Op, typename T>
+   constexpr auto reduce(Op const&, T const& value)
    {
-      using namespace n316;
+      return value;
+   }
 
-      std::cout << Sum<1> << '\n';
-      std::cout << Sum<1, 2> << '\n';
-      std::cout << Sum<1, 2, 3, 4, 5> << '\n';
+   // reduces the pack level by level, halving it each time, so the chain
+   // of dependent operations is log2(N) long instead of N; that takes one
+   // reduce and one pair_up per level, and the arguments are only
+   // referred to, never copied into an array
+   template <typename Op, typename T1, typename T2, typename... Ts>
+   constexpr auto reduce(Op const& op, T1 const& a, T2 const& b, Ts const&... rest)
+   {
+      return pair_up(op, std::forward_as_tuple(a, b, rest...),
+                     std::make_index_sequence<(sizeof...(Ts) + 2) / 2>{});
    }
 
+   struct min_op
    {
-      using namespace n317;
+      template <typename T, typename U>
+      constexpr std::common_type_t<T, U> operator()(T a, U b) const { return b < a ? b : a; }
+   };
 
-      [[maybe_unused]] foo<double, char, int> f1;
-      foo<int, char, double> f2;
-      int_foo<char, double> f3;
-      static_assert(std::is_same_v<decltype(f2), decltype(f3)>);
-   }
+   struct max_op
+   {
+      template <typename T, typename U>
+      constexpr std::common_type_t<T, U> operator()(T a, U b) const { return a < b ? b : a; }
+   };
+
+   template <typename... Ts>
+   constexpr auto min(Ts const&... args) { return reduce(min_op{}, args...); }
+
+   template <typename... Ts>
+   constexpr auto max(Ts const&... args) { return reduce(max_op{}, args...); }
+
+   template <typename... Ts>
+   constexpr auto sum(Ts const&... args) { return reduce(std::plus<>{}, args...); }
+
+   template <typename... Ts>
+   constexpr auto product(Ts const&... args) { return reduce(std::multiplies<>{}, args...); }
+
+   static_assert(min(5, 3, -4, 9, 1) == -4);
+   static_assert(max(5, 3, -4, 9, 1) == 9);
+   static_assert(sum(1, 2, 3, 4, 5) == 15);
+   static_assert(product(1, 2, 3, 4, 5) == 120);
 
+   static_assert(min(2, 1.5) == 1.5);
+
+   template <typename F, typename T, std::size_t N, std::size_t... Is>
+   T apply_row(F const& f, std::array<T, N> const& row, T const x, std::index_sequence<Is...>)
    {
-      using namespace n317;
+      return f((row[Is] + x)...);
+   }
 
-      std::tuple<int, char, double> t1{ 42, 'x', 42.99 };
-      auto t2 = select_tuple(t1, index_sequence<0, 2>{});
+   // every argument of a reduction depends on the result of the previous
+   // one, so the loop runs at the latency of the chain of operations in f
+   // rather than at its throughput
+   template <typename T, std::size_t N, typename F>
+   void reduce_chain(char const* name, std::vector<std::array<T, N>> const& rows,
+                     T const scale, F const& f)
+   {
+      T x{};
+      double const ms = timing::milliseconds([&] {
+         for (int pass = 0; pass < 100; ++pass)
+            for (auto const& row : rows)
+               x = apply_row(f, row, x, std::make_index_sequence<N>{}) * scale;
+      });
+
+      std::cout << name << ": " << ms << " ms, result=" << x << '\n';
    }
+}
 
+namespace n324
+{
+   template <typename T, std::size_t Alignment = 64>
+   struct aligned_allocator
    {
-      using namespace n318;
+      using value_type = T;
 
-      [[maybe_unused]] outer<int, double, char[5]> a;
+      template <typename U>
+      struct rebind { using other = aligned_allocator<U, Alignment>; };
 
-      tagger<int, double, char[5], short, float>();
+      aligned_allocator() = default;
 
-      make_it(42);
-      make_it(42, 'a');
+      template <typename U>
+      aligned_allocator(aligned_allocator<U, Alignment> const&) noexcept {}
 
-      do_sums(1, 2, 3, 4);
+      T* allocate(std::size_t n)
+      {
+         return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{ Alignment }));
+      }
 
-      parenthesized(1, 2, 3, 4);
+      void deallocate(T* p, std::size_t) noexcept
+      {
+         ::operator delete(p, std::align_val_t{ Alignment });
+      }
 
-      brace_enclosed(1, 2, 3, 4);
+      template <typename U>
+      bool operator==(aligned_allocator<U, Alignment> const&) const noexcept { return true; }
+   };
 
-      captures(1, 2, 3, 4);
+   // names a column; a plain type T is its own tag
+   template <typename Tag, typename T>
+   struct field {};
 
-      auto arr = make_array(1, 2, 3, 4);
+   template <typename T>
+   struct field_traits
+   {
+      using tag = T;
+      using type = T;
+   };
 
-      alignment1<int, double> al1;
-      al1.a = 'a';
+   template <typename Tag, typename T>
+   struct field_traits<field<Tag, T>>
+   {
+      using tag = Tag;
+      using type = T;
+   };
 
-      //alignment2<1, 4, 8> al2; // error with VC++
-      //al2.a = 'b';
+   template <typename F>
+   using field_type = typename field_traits<F>::type;
+
+   template <typename F>
+   using column_type = std::vector<field_type<F>, aligned_allocator<field_type<F>>>;
+
+   // index of the only column tagged Tag, or sizeof...(Fs) if there is
+   // no such column or more than one
+   template <typename Tag, typename... Fs>
+   constexpr std::size_t index_of_tag()
+   {
+      constexpr bool matches[] = { std::is_same_v<Tag, typename field_traits<Fs>::tag>... };
+      std::size_t count = 0, index = 0;
+      for (std::size_t i = 0; i < sizeof...(Fs); ++i)
+         if (matches[i] && count++ == 0)
+            index = i;
+      return count == 1 ? index : sizeof...(Fs);
    }
 
+   template <typename... Fs>
+   class soa_vector
    {
-      using namespace n318;
+   public:
+      using value_type = std::tuple<field_type<Fs>...>;
+      using reference = std::tuple<field_type<Fs>&...>;
+      using const_reference = std::tuple<field_type<Fs> const&...>;
 
-      A a;
-      B b;
-      C c;
-      X x(a, b, c);
-      
-      x.A::execute();
-      x.B::execute();
-      x.C::execute();
+      void push_back(field_type<Fs> const &... values)
+      {
+         emplace_back(values...);
+      }
+
+      template <typename... Args>
+      void emplace_back(Args&&... args)
+      {
+         static_assert(sizeof...(Args) == sizeof...(Fs), "one value per column");
+         emplace_back_impl(std::index_sequence_for<Fs...>{}, std::forward<Args>(args)...);
+      }
+
+      reference operator[](std::size_t i)
+      {
+         return row(i, std::index_sequence_for<Fs...>{});
+      }
+
+      const_reference operator[](std::size_t i) const
+      {
+         return row(i, std::index_sequence_for<Fs...>{});
+      }
+
+      template <std::size_t I>
+      auto& column() { return std::get<I>(columns); }
+
+      template <std::size_t I>
+      auto const& column() const { return std::get<I>(columns); }
+
+      template <typename Tag>
+      auto& column()
+      {
+         constexpr auto I = index_of_tag<Tag, Fs...>();
+         static_assert(I < sizeof...(Fs), "tag must name exactly one column");
+         return std::get<I>(columns);
+      }
+
+      template <typename Tag>
+      auto const& column() const
+      {
+         constexpr auto I = index_of_tag<Tag, Fs...>();
+         static_assert(I < sizeof...(Fs), "tag must name exactly one column");
+         return std::get<I>(columns);
+      }
+
+      std::size_t size() const noexcept { return std::get<0>(columns).size(); }
+      bool empty() const noexcept { return size() == 0; }
+
+      void reserve(std::size_t n)
+      {
+         std::apply([n](auto&... c) { (c.reserve(n), ...); }, columns);
+      }
+
+      void clear() noexcept
+      {
+         std::apply([](auto&... c) { (c.clear(), ...); }, columns);
+      }
+
+   private:
+      // all columns grow before any element is added, so only an element
+      // constructor can throw; the columns already appended to are then
+      // popped back and every column keeps the same length
+      template <std::size_t... Is, typename... Args>
+      void emplace_back_impl(std::index_sequence<Is...>, Args&&... args)
+      {
+         std::size_t const n = size();
+         if (((std::get<Is>(columns).capacity() == n) || ...))
+            reserve(n == 0 ? 1 : 2 * n);
+
+         std::size_t appended = 0;
+         try
+         {
+            ((std::get<Is>(columns).emplace_back(std::forward<Args>(args)), ++appended), ...);
+         }
+         catch (...)
+         {
+            ((Is < appended ? std::get<Is>(columns).pop_back() : void()), ...);
+            throw;
+         }
+      }
+
+      template <std::size_t... Is>
+      reference row(std::size_t i, std::index_sequence<Is...>)
+      {
+         return reference(std::get<Is>(columns)[i]...);
+      }
+
+      template <std::size_t... Is>
+      const_reference row(std::size_t i, std::index_sequence<Is...>) const
+      {
+         return const_reference(std::get<Is>(columns)[i]...);
+      }
+
+      std::tuple<column_type<Fs>...> columns;
+   };
+
+   struct id {};
+   struct price {};
+   struct quantity {};
+   struct label {};
+}
+
+namespace n325
+{
+   template <std::size_t N>
+   struct string_literal
+   {
+      constexpr string_literal(char const (&str)[N])
+      {
+         std::copy_n(str, N, value);
+      }
+
+      char value[N];
+   };
+
+   // the format string split into literal text and "{}" placeholders;
+   // "{{" and "}}" stand for literal braces
+   template <std::size_t N>
+   struct format_spec
+   {
+      char        text[N]{};
+      std::size_t text_size = 0;
+      std::size_t splits[N]{};   // offsets in text where arguments go
+      std::size_t arg_count = 0;
+      bool        valid = true;
+
+      constexpr format_spec(string_literal<N> const& fmt)
+      {
+         for (std::size_t i = 0; i + 1 < N; ++i)
+         {
+            char c = fmt.value[i];
+            char next = i + 2 < N ? fmt.value[i + 1] : '\0';
+            if (c == '{' && next == '}')
+            {
+               splits[arg_count++] = text_size;
+               ++i;
+            }
+            else if ((c == '{' && next == '{') || (c == '}' && next == '}'))
+            {
+               text[text_size++] = c;
+               ++i;
+            }
+            else if (c == '{' || c == '}')
+               valid = false;
+            else
+               text[text_size++] = c;
+         }
+      }
+   };
+
+   template <string_literal Fmt>
+   inline constexpr format_spec spec_of(Fmt);
+
+   template <typename T>
+   concept formattable =
+      std::is_arithmetic_v<T> ||
+      std::is_convertible_v<T const&, std::string_view>;
+
+   inline char* write_text(char* first, char* last, std::string_view text)
+   {
+      if (first == nullptr || static_cast<std::size_t>(last - first) < text.size())
+         return nullptr;
+      std::memcpy(first, text.data(), text.size());
+      return first + text.size();
+   }
+
+   template <formattable T>
+   char* write_arg(char* first, char* last, T const& value)
+   {
+      if (first == nullptr)
+         return nullptr;
+      if constexpr (std::is_same_v<T, bool>)
+         return write_text(first, last, value ? "true" : "false");
+      else if constexpr (std::is_same_v<T, char>)
+         return write_text(first, last, std::string_view(&value, 1));
+      else if constexpr (std::is_arithmetic_v<T>)
+      {
+         auto [end, ec] = std::to_chars(first, last, value);
+         return ec == std::errc{} ? end : nullptr;
+      }
+      else
+         return write_text(first, last, std::string_view(value));
+   }
+
+   template <string_literal Fmt, std::size_t... Is, typename... Args>
+   char* format_impl(char* first, char* last, std::index_sequence<Is...>, Args const&... args)
+   {
+      constexpr auto& spec = spec_of<Fmt>;
+      constexpr std::string_view text(spec.text, spec.text_size);
+
+      std::size_t done = 0;
+      ((first = write_text(first, last, text.substr(done, spec.splits[Is] - done)),
+        first = write_arg(first, last, args),
+        done = spec.splits[Is]), ...);
+      return write_text(first, last, text.substr(done));
+   }
+
+   // writes the formatted text to [first, last) and returns the end of the
+   // output, or nullptr if it does not fit
+   template <string_literal Fmt, typename... Args>
+   char* format_to(char* first, char* last, Args const&... args)
+   {
+      constexpr auto& spec = spec_of<Fmt>;
+      static_assert(spec.valid, "unmatched brace in format string");
+      static_assert(spec.arg_count == sizeof...(Args),
+                    "number of arguments does not match the format string");
+      static_assert((formattable<Args> && ...), "argument type cannot be formatted");
+
+      return format_impl<Fmt>(first, last, std::index_sequence_for<Args...>{}, args...);
+   }
+
+   // collects formatted output and writes it to the file in large blocks
+   class output_buffer
+   {
+   public:
+      explicit output_buffer(std::FILE* out = stdout) : out(out) {}
+      output_buffer(output_buffer const&) = delete;
+      output_buffer& operator=(output_buffer const&) = delete;
+      ~output_buffer() { flush(); }
+
+      template <string_literal Fmt, typename... Args>
+      void print(Args const&... args)
+      {
+         char* end = format_to<Fmt>(data + used, data + sizeof(data), args...);
+         if (end == nullptr)
+         {
+            flush();
+            end = format_to<Fmt>(data, data + sizeof(data), args...);
+            if (end == nullptr)
+            {
+               write_large<Fmt>(args...);
+               return;
+            }
+         }
+         used = static_cast<std::size_t>(end - data);
+      }
+
+      void flush()
+      {
+         if (used > 0)
+         {
+            std::fwrite(data, 1, used, out);
+            std::fflush(out);
+         }
+         used = 0;
+      }
+
+   private:
+      // a message larger than the buffer is formatted into a temporary
+      // that grows until it fits, and written straight to the file
+      template <string_literal Fmt, typename... Args>
+      void write_large(Args const&... args)
+      {
+         std::vector<char> large(2 * sizeof(data));
+         char* end;
+         while ((end = format_to<Fmt>(large.data(), large.data() + large.size(), args...)) == nullptr)
+            large.resize(2 * large.size());
+         std::fwrite(large.data(), 1, static_cast<std::size_t>(end - large.data()), out);
+         std::fflush(out);
+      }
+
+      std::FILE*  out;
+      std::size_t used = 0;
+      char        data[1 << 16];
+   };
+
+   inline output_buffer& thread_buffer()
+   {
+      thread_local output_buffer buffer;
+      return buffer;
+   }
+
+   template <string_literal Fmt, typename... Args>
+   void print(Args const&... args)
+   {
+      thread_buffer().print<Fmt>(args...);
+   }
+
+   inline void flush()
+   {
+      thread_buffer().flush();
+   }
+}
+
+namespace n326
+{
+   // grows v so that n more elements fit: exactly n for a fresh vector,
+   // but never less than the usual doubling when appending repeatedly
+   template <typename T, typename Allocator>
+   void reserve_for(std::vector<T, Allocator>& v, std::size_t n)
+   {
+      if (v.capacity() - v.size() < n)
+         v.reserve(std::max(v.size() + n, 2 * v.capacity()));
+   }
+
+   template <typename T, typename Allocator, typename... Args>
+   void emplace_many(std::vector<T, Allocator>& v, Args&&... args)
+   {
+      reserve_for(v, sizeof...(args));
+      (v.emplace_back(std::forward<Args>(args)), ...);
+   }
+
+   template <typename T, typename Allocator, typename... Args>
+   void append_many(std::vector<T, Allocator>& v, Args&&... args)
+   {
+      static_assert((std::is_convertible_v<Args&&, T> && ...),
+                    "arguments must be implicitly convertible to the element type");
+      reserve_for(v, sizeof...(args));
+      (v.push_back(std::forward<Args>(args)), ...);
+   }
+
+   template <template <typename> class Allocator, typename T, typename... Ts>
+   auto make_vector_moved(T&& first, Ts&&... args)
+   {
+      std::vector<std::decay_t<T>, Allocator<std::decay_t<T>>> v;
+      emplace_many(v, std::forward<T>(first), std::forward<Ts>(args)...);
+      return v;
+   }
+
+   template <typename T, typename... Ts>
+   auto make_vector_moved(T&& first, Ts&&... args)
+   {
+      return make_vector_moved<std::allocator>(std::forward<T>(first), std::forward<Ts>(args)...);
+   }
+
+   struct counters
+   {
+      static inline std::size_t allocations = 0;
+      static inline std::size_t copies = 0;
+      static inline std::size_t moves = 0;
+
+      static void reset() { allocations = copies = moves = 0; }
+
+      static void print(char const* name)
+      {
+         std::cout << name << ": allocations=" << allocations
+                   << " copies=" << copies
+                   << " moves=" << moves << '\n';
+      }
+   };
+
+   template <typename T>
+   struct counting_allocator
+   {
+      using value_type = T;
+
+      counting_allocator() = default;
+
+      template <typename U>
+      counting_allocator(counting_allocator<U> const&) noexcept {}
+
+      T* allocate(std::size_t n)
+      {
+         ++counters::allocations;
+         return std::allocator<T>{}.allocate(n);
+      }
+
+      void deallocate(T* p, std::size_t n) noexcept
+      {
+         std::allocator<T>{}.deallocate(p, n);
+      }
+
+      template <typename U>
+      bool operator==(counting_allocator<U> const&) const noexcept { return true; }
+   };
+
+   struct tracked
+   {
+      tracked(char const* s) : value(s) {}
+      tracked(tracked const& other) : value(other.value) { ++counters::copies; }
+      tracked(tracked&& other) noexcept : value(std::move(other.value)) { ++counters::moves; }
+
+      std::string value;
+   };
+
+   template <typename T>
+   using counted_vector = std::vector<T, counting_allocator<T>>;
+
+   struct large_object
+   {
+      std::array<char, 512> payload{};
+   };
+
+   template <typename F>
+   void measure(char const* name, int count, F&& f)
+   {
+      std::size_t total = 0;
+      double const ms = timing::milliseconds([&] {
+         for (int i = 0; i < count; ++i)
+            total += f();
+      });
+
+      std::cout << name << ": " << ms << " ms, total=" << total << '\n';
+   }
+}
+
+namespace n327
+{
+   struct sequential_t {};
+   struct parallel_t {};
+
+   inline constexpr sequential_t sequential{};
+   inline constexpr parallel_t parallel{};
+
+   class worker_pool
+   {
+   public:
+      explicit worker_pool(unsigned count = std::max(1u, std::thread::hardware_concurrency()))
+      {
+         for (unsigned i = 0; i < count; ++i)
+            workers.emplace_back([this] { work(); });
+      }
+
+      worker_pool(worker_pool const&) = delete;
+      worker_pool& operator=(worker_pool const&) = delete;
+
+      ~worker_pool()
+      {
+         {
+            std::lock_guard lock(mt);
+            stopping = true;
+         }
+         cv.notify_all();
+         for (auto& w : workers)
+            w.join();
+      }
+
+      void submit(std::function<void()> job)
+      {
+         {
+            std::lock_guard lock(mt);
+            jobs.push(std::move(job));
+         }
+         cv.notify_one();
+      }
+
+      // runs one queued job on the calling thread, if there is one; a
+      // thread waiting for its jobs helps with this so that nested use
+      // cannot block every worker on jobs still queued behind it
+      bool try_run_one()
+      {
+         std::function<void()> job;
+         {
+            std::lock_guard lock(mt);
+            if (jobs.empty())
+               return false;
+            job = std::move(jobs.front());
+            jobs.pop();
+         }
+         job();
+         return true;
+      }
+
+   private:
+      void work()
+      {
+         for (;;)
+         {
+            std::function<void()> job;
+            {
+               std::unique_lock lock(mt);
+               cv.wait(lock, [this] { return stopping || !jobs.empty(); });
+               if (jobs.empty())
+                  return;
+               job = std::move(jobs.front());
+               jobs.pop();
+            }
+            job();
+         }
+      }
+
+      std::mutex                        mt;
+      std::condition_variable           cv;
+      std::queue<std::function<void()>> jobs;
+      std::vector<std::thread>          workers;
+      bool                              stopping = false;
+   };
+
+   inline worker_pool& default_pool()
+   {
+      static worker_pool pool;
+      return pool;
+   }
+
+   // stands in for the result of an execute() that returns void
+   struct no_result {};
+
+   template <typename F>
+   decltype(auto) call(F& f)
+   {
+      if constexpr (std::is_void_v<std::invoke_result_t<F&>>)
+      {
+         f();
+         return no_result{};
+      }
+      else
+         return f();
+   }
+
+   template <typename F>
+   using result_t = decltype(call(std::declval<F&>()));
+
+   template <typename... Fs>
+   auto run_all(sequential_t, Fs... fs)
+   {
+      // braced initialization runs the tasks left to right
+      return std::tuple<result_t<Fs>...>{ call(fs)... };
+   }
+
+   template <std::size_t... Is, typename... Fs>
+   auto run_all_parallel(worker_pool& pool, std::index_sequence<Is...>, Fs&... fs)
+   {
+      constexpr std::size_t N = sizeof...(Fs);
+      std::tuple<std::optional<result_t<Fs>>...> slots;
+      std::array<std::exception_ptr, N> errors;
+      std::latch done(N);
+
+      auto run_one = [&]<std::size_t I, typename F>(F& f) {
+         try
+         {
+            std::get<I>(slots).emplace(call(f));
+         }
+         catch (...)
+         {
+            errors[I] = std::current_exception();
+         }
+         done.count_down();
+      };
+
+      // the calling thread runs the last task itself instead of idling
+      ((Is + 1 < N
+           ? pool.submit([&] { run_one.template operator()<Is>(fs); })
+           : run_one.template operator()<Is>(fs)), ...);
+      while (!done.try_wait())
+         if (!pool.try_run_one())
+            std::this_thread::yield();
+
+      for (auto const& e : errors)
+         if (e)
+            std::rethrow_exception(e);
+
+      return std::tuple<result_t<Fs>...>(std::move(*std::get<Is>(slots))...);
+   }
+
+   template <typename... Fs>
+   auto run_all(parallel_t, Fs... fs)
+   {
+      return run_all_parallel(default_pool(), std::index_sequence_for<Fs...>{}, fs...);
+   }
+
+   // runs Base::execute() for every base of a mixin such as n318::X
+   template <typename Policy, template <typename...> class Mixin, typename... Bases>
+   auto execute_all(Policy policy, Mixin<Bases...>& object)
+   {
+      return run_all(policy, [&object] { return static_cast<Bases&>(object).execute(); }...);
+   }
+
+   // runs execute() on every element of a tuple of tasks
+   template <typename Policy, typename... Tasks>
+   auto execute_all(Policy policy, std::tuple<Tasks...>& tasks)
+   {
+      return std::apply([policy](auto&... task) {
+         return run_all(policy, [&task] { return task.execute(); }...);
+      }, tasks);
+   }
+
+   struct count_primes
+   {
+      int limit;
+
+      int execute() const
+      {
+         int count = 0;
+         for (int n = 2; n < limit; ++n)
+         {
+            bool prime = true;
+            for (int d = 2; d * d <= n && prime; ++d)
+               prime = n % d != 0;
+            count += prime;
+         }
+         return count;
+      }
+   };
+
+   struct sum_series
+   {
+      int terms;
+
+      double execute() const
+      {
+         double total = 0;
+         for (int k = 1; k <= terms; ++k)
+            total += 1.0 / (double(k) * k);
+         return total;
+      }
+   };
+
+   struct build_label
+   {
+      std::string execute() const { return "stages done"; }
+   };
+
+   template <typename Policy>
+   void run_stages(char const* name, Policy policy, int const limit)
+   {
+      std::tuple stages{ count_primes{ limit }, count_primes{ limit },
+                         sum_series{ 50 * limit }, build_label{} };
+
+      std::tuple<int, int, double, std::string> results;
+      double const ms = timing::milliseconds([&] { results = execute_all(policy, stages); });
+
+      auto const& [primes1, primes2, series, label] = results;
+      std::cout << name << ": " << primes1 << ',' << primes2 << ','
+                << series << ',' << label << ", " << ms << " ms\n";
+   }
+}
+
+namespace n328
+{
+#ifdef __cpp_lib_hardware_interference_size
+   inline constexpr std::size_t cache_line_size = std::hardware_destructive_interference_size;
+#else
+   inline constexpr std::size_t cache_line_size = 64;
+#endif
+
+   // gives T a cache line of its own so that writes to neighbouring
+   // objects from other threads do not invalidate it
+   template <typename T>
+   struct alignas(cache_line_size) cache_padded
+   {
+      cache_padded() = default;
+
+      template <typename... Args>
+      explicit cache_padded(std::in_place_t, Args&&... args)
+         : value(std::forward<Args>(args)...)
+      {
+      }
+
+      T& operator*() noexcept { return value; }
+      T const& operator*() const noexcept { return value; }
+      T* operator->() noexcept { return &value; }
+      T const* operator->() const noexcept { return &value; }
+
+      T value{};
+   };
+
+   static_assert(sizeof(cache_padded<char>) == cache_line_size);
+   static_assert(alignof(cache_padded<long>) == cache_line_size);
+
+   inline std::size_t thread_slot()
+   {
+      static std::atomic<std::size_t> next{ 0 };
+      thread_local std::size_t slot = next.fetch_add(1, std::memory_order_relaxed);
+      return slot;
+   }
+
+   // one padded T per thread; threads beyond N share slots, so T should be
+   // safe to update concurrently (an atomic) unless there are at most N threads
+   template <typename T, std::size_t N = 64>
+   class per_thread
+   {
+   public:
+      T& local() noexcept { return *slots[thread_slot() % N]; }
+
+      template <typename U, typename Op>
+      U combine(U init, Op op) const
+      {
+         for (auto const& slot : slots)
+            init = op(init, *slot);
+         return init;
+      }
+
+   private:
+      std::array<cache_padded<T>, N> slots{};
+   };
+
+   template <typename Counters, typename Increment>
+   void count_in_threads(char const* name, int threads, int increments,
+                         Counters& counters, Increment increment)
+   {
+      double const ms = timing::milliseconds([&] {
+         std::vector<std::thread> workers;
+         for (int t = 0; t < threads; ++t)
+            workers.emplace_back([&, t] {
+               for (int i = 0; i < increments; ++i)
+                  increment(counters, t);
+            });
+         for (auto& w : workers)
+            w.join();
+      });
+
+      std::cout << name << ": " << ms << " ms\n";
+   }
+}
+
+namespace n329
+{
+   // left-to-right, like the fold expression in n318::sum_wrapper
+   struct naive {};
+
+   // sums halves recursively; the leaves use independent accumulators the
+   // compiler can map to SIMD lanes, and the error grows as O(log n)
+   struct pairwise {};
+
+   // Neumaier's variant of Kahan summation; the error does not grow with n
+   struct neumaier {};
+
+   template <typename T>
+   T sum(naive, std::span<T const> values)
+   {
+      T total{};
+      for (T v : values)
+         total += v;
+      return total;
+   }
+
+   template <typename T>
+   T sum(pairwise, std::span<T const> values)
+   {
+      constexpr std::size_t block = 256;
+      constexpr std::size_t lanes = 8;
+
+      if (values.size() <= block)
+      {
+         T acc[lanes]{};
+         std::size_t i = 0;
+         for (; i + lanes <= values.size(); i += lanes)
+            for (std::size_t l = 0; l < lanes; ++l)
+               acc[l] += values[i + l];
+         for (; i < values.size(); ++i)
+            acc[0] += values[i];
+         return ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+      }
+
+      std::size_t half = values.size() / 2 / lanes * lanes;
+      return sum(pairwise{}, values.first(half)) + sum(pairwise{}, values.subspan(half));
+   }
+
+   template <typename T>
+   T sum(neumaier, std::span<T const> values)
+   {
+      T total{};
+      T compensation{};
+      for (T v : values)
+      {
+         T t = total + v;
+         compensation += std::abs(total) >= std::abs(v) ? (total - t) + v : (v - t) + total;
+         total = t;
+      }
+      return total + compensation;
+   }
+
+   template <typename Policy, typename T>
+   T sum(Policy policy, std::vector<T> const& values)
+   {
+      return sum(policy, std::span<T const>(values));
+   }
+
+   template <typename Policy, typename... Ts>
+   auto sum_of(Policy policy, Ts... args)
+   {
+      std::array<std::common_type_t<Ts...>, sizeof...(Ts)> values{ args... };
+      return sum(policy, std::span<std::common_type_t<Ts...> const>(values));
+   }
+
+   template <typename Policy, typename... T>
+   struct sum_wrapper
+   {
+      sum_wrapper(T... args)
+      {
+         value = sum_of(Policy{}, args...);
+      }
+
+      std::common_type_t<T...> value;
+   };
+
+   template <typename F>
+   void report(char const* name, std::size_t count, long double exact, F&& f)
+   {
+      long double result = 0;
+      double const ms = timing::milliseconds([&] { result = f(); });
+
+      std::cout << name << ": relative error="
+                << static_cast<double>(std::fabs((result - exact) / exact))
+                << ", " << count / ms / 1000 << " Melem/s\n";
+   }
+}
+
+namespace n330
+{
+   // calls the stages left to right, each on the result of the previous
+   // one; the stages are stored by value, so the whole chain is one type
+   // the compiler can inline. Results are returned by value, since a stage
+   // returning a reference may refer to a temporary made by an earlier one
+   template <typename... Fs>
+   struct composed
+   {
+      std::tuple<Fs...> stages;
+
+      template <typename... Args>
+      constexpr auto operator()(Args&&... args) const
+      {
+         return call<0>(std::forward<Args>(args)...);
+      }
+
+   private:
+      template <std::size_t I, typename... Args>
+      constexpr auto call(Args&&... args) const
+      {
+         if constexpr (I + 1 == sizeof...(Fs))
+            return std::invoke(std::get<I>(stages), std::forward<Args>(args)...);
+         else
+            return call<I + 1>(std::invoke(std::get<I>(stages), std::forward<Args>(args)...));
+      }
+   };
+
+   template <typename... Fs>
+   constexpr auto compose(Fs... fs)
+   {
+      static_assert(sizeof...(Fs) > 0, "nothing to compose");
+      return composed<Fs...>{ { fs... } };
+   }
+
+   template <typename... Fs, typename G>
+   constexpr auto operator|(composed<Fs...> const& f, G g)
+   {
+      return std::apply([&g](auto const&... fs) { return compose(fs..., g); }, f.stages);
+   }
+
+   template <typename... Fs, typename... Gs>
+   constexpr auto operator|(composed<Fs...> const& f, composed<Gs...> const& g)
+   {
+      return composed<Fs..., Gs...>{ std::tuple_cat(f.stages, g.stages) };
+   }
+
+   // runs the pipeline over a whole range in a single loop
+   template <typename Pipeline, typename T, typename U>
+   void apply(Pipeline const& pipeline, std::span<T const> in, std::span<U> out)
+   {
+      std::size_t n = std::min(in.size(), out.size());
+      for (std::size_t i = 0; i < n; ++i)
+         out[i] = pipeline(in[i]);
+   }
+}
+
+int main(int argc, char* argv[])
+{
+   // the timing runs use full-size inputs only with --bench; by default
+   // they use small ones so that the samples finish in a moment
+   bool const bench = argc > 1 && std::string_view(argv[1]) == "--bench";
+
+   {
+      using namespace n301;
+
+      std::cout << "min(42, 7)=" << min(2, 42, 7) << '\n';
+      std::cout << "min(1,5,3,-4,9)=" << min(5, 1, 5, 3, -4, 9) << '\n';
+   }
+
+   {
+      using namespace n302;
+
+      std::cout << "min(42.0, 7.5)=" << min<double>(2, 42.0, 7.5) << '\n';
+      std::cout << "min(1,5,3,-4,9)=" << min<int>(5, 1, 5, 3, -4, 9) << '\n';
+   }
+
+   {
+      using namespace n303;
+
+      std::cout << "min(42.0, 7.5)=" << min(42.0, 7.5) << '\n';
+      std::cout << "min(1,5,3,-4,9)=" << min(1, 5, 3, -4, 9) << '\n';
+   }
+
+   {
+      using namespace n304;
+
+      std::cout << "min(42, 7)=" << min(42, 7) << '\n';
+      std::cout << "min(1,5,3,-4,9)=" << min(1, 5, 3, -4, 9) << '\n';
+   }
+
+   {
+      using namespace n305;
+
+      min(1, 5, 3, -4, 9);
+   }
+
+   {
+      using namespace n306;
+
+      std::cout << sum(1, 2, 3, 4, 5) << '\n';
+      std::cout << sum(1) << '\n';
+   }
+
+   {
+      using namespace n307;
+
+      std::cout << sum(1, 2, 3, 4, 5) << '\n';
+      std::cout << sum(1) << '\n';
+   }
+
+   {
+      using namespace n308;
+
+      auto sizes = get_type_sizes<short, int, long, long long>();
+      for (auto const& s : sizes)
+         std::cout << s << '\n';
+   }
+
+   {
+      using namespace n310;
+      multipacks<int>(1, 2, 3, 4, 5, 6);                    // 1,5
+      multipacks<int, int, int>(1, 2, 3, 4, 5, 6);          // 3,3
+      multipacks<int, int, int, int>(1, 2, 3, 4, 5, 6);     // 4,2
+      multipacks<int, int, int, int, int, int>(1, 2, 3, 4, 5, 6); // 6,0
+
+      multipacks<int, int>(1, 2, 4.0, 5.0, 6.0);            // 2,3
+      multipacks<int, int, int>(1, 2, 3, 4.0, 5.0, 6.0);    // 3,3
+   }
+
+   {
+      using namespace n311;
+      //multipacks<int>(1, 2, 3, 4, 5, 6);                    // error
+      multipacks<int, int, int>(1, 2, 3, 4, 5, 6);          // OK
+      //multipacks<int, int, int, int>(1, 2, 3, 4, 5, 6);     // error
+      //multipacks<int, int, int, int, int, int>(1, 2, 3, 4, 5, 6); // error
+
+      //multipacks<int, int>(1, 2, 4.0, 5.0, 6.0);            // error
+      multipacks<int, int, int>(1, 2, 3, 4.0, 5.0, 6.0);    // OK
+   }
+
+   {
+      using namespace n312;
+
+      func_pair<bool(int, int), double(int, int, double)> funcs{ twice_as, sum_and_div };
+      funcs.f(42, 12);
+      funcs.g(42, 12, 10.0);
+   }
+
+   {
+      using namespace n313;
+
+      tuple<int> one(42);
+      tuple<int, double> two(42, 42.0);
+      tuple<int, double, char> three(42, 42.0, 'a');
+
+      std::cout << one.value << '\n';
+      std::cout << two.value << ',' 
+                << two.rest.value << '\n';
+      std::cout << three.value << ',' 
+                << three.rest.value << ','
+                << three.rest.rest.value << '\n';
+
+      std::cout << get<0>(one) << '\n';
+      std::cout << get<0>(two) << ','
+                << get<1>(two) << '\n';
+      std::cout << get<0>(three) << ','
+                << get<1>(three) << ','
+                << get<2>(three) << '\n';
+   }
+
+   {
+      using namespace n314;
+
+      // std::cout << sum() << '\n'; // error
+      std::cout << sum(1) << '\n';
+      std::cout << sum(1, 2) << '\n';
+      std::cout << sum(1, 2, 3, 4, 5) << '\n';
+
+      std::cout << sum_from_zero() << '\n';
+      std::cout << sum_from_zero(1, 2, 3) << '\n';
+   }
+
+   {
+      using namespace n315;
+
+      printl('d', 'o', 'g');  // dog
+      printr('d', 'o', 'g');  // dog
+      print('d', 'o', 'g');  // dog
+   }
+
+   {
+      using namespace n315;
+
+      std::vector<int> v;
+      push_back_many(v, 1, 2, 3, 4, 5);
+   }
+
+   {
+      using namespace n316;
+
+      std::cout << Sum<1> << '\n';
+      std::cout << Sum<1, 2> << '\n';
+      std::cout << Sum<1, 2, 3, 4, 5> << '\n';
+   }
+
+   {
+      using namespace n317;
+
+      [[maybe_unused]] foo<double, char, int> f1;
+      foo<int, char, double> f2;
+      int_foo<char, double> f3;
+      static_assert(std::is_same_v<decltype(f2), decltype(f3)>);
+   }
+
+   {
+      using namespace n317;
+
+      std::tuple<int, char, double> t1{ 42, 'x', 42.99 };
+      auto t2 = select_tuple(t1, index_sequence<0, 2>{});
+      auto t3 = select_tuple(t1, index_sequence_for<int, char, double>{});
+      static_assert(std::is_same_v<decltype(t1), decltype(t3)>);
+
+      static_assert(std::is_same_v<make_index_sequence<5>,
+                                   index_sequence<0, 1, 2, 3, 4>>);
+      static_assert(make_index_sequence<10000>::size() == 10000);
+   }
+
+   {
+      using namespace n318;
+
+      [[maybe_unused]] outer<int, double, char[5]> a;
+
+      tagger<int, double, char[5], short, float>();
+
+      make_it(42);
+      make_it(42, 'a');
+
+      do_sums(1, 2, 3, 4);
+
+      parenthesized(1, 2, 3, 4);
+
+      brace_enclosed(1, 2, 3, 4);
+
+      captures(1, 2, 3, 4);
+
+      auto arr = make_array(1, 2, 3, 4);
+
+      alignment1<int, double> al1;
+      al1.a = 'a';
+
+      //alignment2<1, 4, 8> al2; // error with VC++
+      //al2.a = 'b';
+   }
+
+   {
+      using namespace n318;
+
+      A a;
+      B b;
+      C c;
+      X x(a, b, c);
+      
+      x.A::execute();
+      x.B::execute();
+      x.C::execute();
+   }
+
+   {
+      using namespace n319;
+
+      tuple<int> one(42);
+      tuple<int, double> two(42, 42.0);
+      tuple<int, double, char> three(42, 42.0, 'a');
+
+      std::cout << get<0>(one) << '\n';
+      std::cout << get<0>(two) << ','
+                << get<1>(two) << '\n';
+      std::cout << get<0>(three) << ','
+                << get<1>(three) << ','
+                << get<2>(three) << '\n';
+
+      std::cout << sizeof(n313::tuple<char, char, int>) << ','        // 12
+                << sizeof(tuple<char, char, int>) << '\n';              // 8
+      std::cout << sizeof(n313::tuple<char, short, char, int>) << ','  // 16
+                << sizeof(tuple<char, short, char, int>) << '\n';       // 12
+
+      uniform_tuple<int, 500> big = {};
+      get<499>(big) = 42;
+      std::cout << get<499>(big) << ',' << big.size() << '\n';
+
+      tuple<> empty;
+      std::cout << empty.size() << '\n';                              // 0
+   }
+
+   {
+      using namespace n320;
+
+      tuple<char, double, char, int> t('a', 42.5, 'b', 42);
+      std::cout << get<0>(t) << ','
+                << get<1>(t) << ','
+                << get<2>(t) << ','
+                << get<3>(t) << '\n';
+
+      std::cout << sizeof(n313::tuple<char, double, char, int>) << ','  // 24
+                << sizeof(n319::tuple<char, double, char, int>) << ','  // 24
+                << sizeof(tuple<char, double, char, int>) << '\n';     // 16
+
+      tuple<> empty;
+      std::cout << empty.size() << '\n';                              // 0
+
+      std::size_t const count = bench ? 10'000'000 : 100'000;
+      std::cout << "declared order:\n";
+      scan<n319::tuple<char, double, char, int>>(count);
+      std::cout << "sorted by alignment:\n";
+      scan<tuple<char, double, char, int>>(count);
+   }
+
+   {
+      using namespace n321;
+
+      print_layout<hot_entry_layout>("hot_entry");
+      print_layout<layout_of<n319::tuple<char, double, char, int>>>("tuple<char, double, char, int>");
+      print_layout<layout<int, char[62], double>>("record");
+   }
+
+   {
+      using namespace n322;
+
+      n312::func_pair<bool(int, int), double(int, int, double), inplace_function> funcs1{
+         n312::twice_as, n312::sum_and_div };
+      std::cout << funcs1.f(42, 12) << ',' << funcs1.g(42, 12, 10.0) << '\n';
+
+      int offset = 1;
+      auto shifted_twice_as = [offset](int a, int b) { return n312::twice_as(a + offset, b); };
+      n312::func_pair<bool(int, int), double(int, int, double), function_ref> funcs2{
+         shifted_twice_as, n312::sum_and_div };
+      std::cout << funcs2.f(42, 12) << ',' << funcs2.g(42, 12, 10.0) << '\n';
+
+      function_ref<bool(int, int)> fr = &n312::twice_as;
+      std::cout << fr(42, 12) << '\n';
+
+      static_assert(!std::is_constructible_v<inplace_function<bool(int, int)>, int>);
+
+      int const count = bench ? 10'000'000 : 100'000;
+      construct_and_invoke<std::function>("std::function", count);
+      construct_and_invoke<inplace_function>("inplace_function", count);
+      construct_and_invoke<function_ref>("function_ref", count);
+   }
+
+   {
+      std::cout << n323::min(1, 5, 3, -4, 9) << ','
+                << n323::max(1, 5, 3, -4, 9) << ','
+                << n323::sum(1, 2, 3, 4, 5) << ','
+                << n323::product(1, 2, 3, 4, 5) << '\n';
+
+      std::vector<std::array<double, 64>> reals(bench ? 1 << 14 : 1 << 8);
+      for (std::size_t r = 0; r < reals.size(); ++r)
+         for (std::size_t i = 0; i < 64; ++i)
+            reals[r][i] = 0.5 * ((r * 64 + i) % 1000);
+
+      n323::reduce_chain("linear sum x64", reals, 1.0 / 64, [](auto... v) { return n307::sum(v...); });
+      n323::reduce_chain("tree sum x64", reals, 1.0 / 64, [](auto... v) { return n323::sum(v...); });
+      n323::reduce_chain("linear min x64", reals, 0.5, [](auto... v) { return n303::min(v...); });
+      n323::reduce_chain("tree min x64", reals, 0.5, [](auto... v) { return n323::min(v...); });
+   }
+
+   {
+      using namespace n324;
+
+      soa_vector<field<id, int>, field<price, double>, field<quantity, double>, field<label, std::array<char, 16>>> rows;
+      std::vector<std::tuple<int, double, double, std::array<char, 16>>> tuples;
+
+      int const count = bench ? 4'000'000 : 40'000;
+      rows.reserve(count);
+      tuples.reserve(count);
+      for (int i = 0; i < count; ++i)
+      {
+         rows.emplace_back(i, 0.25 * (i % 100), 1.0, std::array<char, 16>{ 'x' });
+         tuples.emplace_back(i, 0.25 * (i % 100), 1.0, std::array<char, 16>{ 'x' });
+      }
+
+      auto [first_id, first_price, first_quantity, first_label] = rows[1];
+      first_quantity = 2.0;
+      std::cout << first_id << ',' << first_price << ','
+                << std::get<2>(rows[1]) << ',' << rows.column<price>().size() << '\n';
+      std::get<2>(rows[1]) = 1.0;
+
+      double total = 0;
+      double ms = timing::milliseconds([&] {
+         for (auto const& t : tuples)
+            total += std::get<1>(t);
+      });
+      std::cout << "vector<tuple> scan: " << ms << " ms, total=" << total << '\n';
+
+      total = 0;
+      ms = timing::milliseconds([&] {
+         for (double p : rows.column<price>())
+            total += p;
+      });
+      std::cout << "soa_vector scan: " << ms << " ms, total=" << total << '\n';
+   }
+
+   {
+      using namespace n325;
+
+      std::cout.flush();
+      print<"{} + {} = {}\n">(1, 2, 3);
+      print<"{}, {}, {} {{braces}}\n">(42.5, 'x', "dog");
+      //print<"{} {}\n">(1);                 // error: argument count
+      //print<"{}\n">(std::vector<int>{});   // error: not formattable
+      flush();
+
+      if (std::FILE* file = std::tmpfile())
+      {
+         {
+            output_buffer buffer(file);
+            buffer.print<"{}\n">(std::string(100'000, '.'));   // larger than the buffer
+         }
+         std::cout << std::ftell(file) << " bytes written\n";  // 100001
+         std::fclose(file);
+      }
+
+      int const count = bench ? 1'000'000 : 10'000;
+      char line[128];
+
+      std::size_t length = 0;
+      double ms = timing::milliseconds([&] {
+         for (int i = 0; i < count; ++i)
+         {
+            char* end = format_to<"id={} price={} qty={} ok={}\n">(
+               line, line + sizeof(line), i, i * 0.25, i % 100, i % 2 == 0);
+            length += end - line;
+         }
+      });
+      std::cout << "format_to: " << ms << " ms, " << length << " chars\n";
+
+      // the n315::print fold, writing to memory like format_to does; the
+      // prices are exact in binary, so max_digits10 prints them as short
+      // as to_chars does, and the text only differs where to_chars picks
+      // the shorter scientific form (1e+05 for 100000)
+      length = 0;
+      std::ostringstream os;
+      os << std::boolalpha << std::setprecision(std::numeric_limits<double>::max_digits10);
+      auto fold = [&os](auto const&... args) { (os << ... << args); };
+      ms = timing::milliseconds([&] {
+         for (int i = 0; i < count; ++i)
+         {
+            os.str({});
+            fold("id=", i, " price=", i * 0.25, " qty=", i % 100, " ok=", i % 2 == 0, '\n');
+            length += static_cast<std::size_t>(os.tellp());
+         }
+      });
+      std::cout << "ostream fold: " << ms << " ms, " << length << " chars\n";
+
+#ifdef __cpp_lib_format
+      length = 0;
+      ms = timing::milliseconds([&] {
+         for (int i = 0; i < count; ++i)
+         {
+            auto r = std::format_to_n(line, sizeof(line), "id={} price={} qty={} ok={}\n",
+                                      i, i * 0.25, i % 100, i % 2 == 0);
+            length += r.size;
+         }
+      });
+      std::cout << "std::format_to_n: " << ms << " ms, " << length << " chars\n";
+#endif
+   }
+
+   {
+      using namespace n326;
+
+      char const* s = "a string that is too long for small buffer optimization";
+
+      counters::reset();
+      {
+         counted_vector<tracked> v;
+         [](auto& v, auto&&... args) { (v.push_back(args), ...); }(
+            v, tracked(s), tracked(s), tracked(s), tracked(s), tracked(s));
+      }
+      counters::print("push_back_many   ");
+
+      counters::reset();
+      {
+         counted_vector<tracked> v{ tracked(s), tracked(s), tracked(s), tracked(s), tracked(s) };
+      }
+      counters::print("initializer_list ");
+
+      counters::reset();
+      {
+         counted_vector<tracked> v;
+         emplace_many(v, tracked(s), tracked(s), tracked(s), tracked(s), tracked(s));
+      }
+      counters::print("emplace_many     ");
+
+      counters::reset();
+      {
+         counted_vector<tracked> v;
+         emplace_many(v, s, s, s, s, s);
+      }
+      counters::print("emplace_many(s)  ");
+
+      counters::reset();
+      {
+         auto v = make_vector_moved<counting_allocator>(
+            tracked(s), tracked(s), tracked(s), tracked(s), tracked(s));
+      }
+      counters::print("make_vector_moved");
+
+      int const count = bench ? 200'000 : 2'000;
+      std::string str(s);
+      measure("strings, push_back_many", count, [&] {
+         std::vector<std::string> v;
+         n315::push_back_many(v, str, str, str, str, str, str, str, str);
+         return v.size();
+      });
+      measure("strings, initializer_list", count, [&] {
+         std::vector<std::string> v{ str, str, str, str, str, str, str, str };
+         return v.size();
+      });
+      measure("strings, emplace_many", count, [&] {
+         std::vector<std::string> v;
+         emplace_many(v, str, str, str, str, str, str, str, str);
+         return v.size();
+      });
+
+      // temporaries: push_back_many still copies them, make_vector_moved
+      // moves them
+      measure("temporary strings, push_back_many", count, [&] {
+         std::vector<std::string> v;
+         n315::push_back_many(v, std::string(s), std::string(s), std::string(s), std::string(s),
+                                 std::string(s), std::string(s), std::string(s), std::string(s));
+         return v.size();
+      });
+      measure("temporary strings, make_vector_moved", count, [&] {
+         auto v = make_vector_moved(std::string(s), std::string(s), std::string(s), std::string(s),
+                                    std::string(s), std::string(s), std::string(s), std::string(s));
+         return v.size();
+      });
+
+      // both copy, since the objects are lvalues; the difference is
+      // the single allocation
+      large_object lo;
+      measure("large objects, push_back_many", count, [&] {
+         std::vector<large_object> v;
+         n315::push_back_many(v, lo, lo, lo, lo, lo, lo, lo, lo);
+         return v.size();
+      });
+      measure("large objects, make_vector_moved", count, [&] {
+         auto v = make_vector_moved(lo, lo, lo, lo, lo, lo, lo, lo);
+         return v.size();
+      });
+   }
+
+   {
+      using namespace n327;
+
+      n318::A a;
+      n318::B b;
+      n318::C c;
+      n318::X x(a, b, c);
+
+      [[maybe_unused]] std::tuple<no_result, no_result, no_result> r =
+         execute_all(sequential, x);
+      execute_all(parallel, x);
+
+      // the inner run_all is called on a worker, and waits for its own
+      // tasks by running them
+      auto inner = [] {
+         auto [one, two] = run_all(parallel, [] { return 1; }, [] { return 2; });
+         return one + two;
+      };
+      auto [three, four] = run_all(parallel, inner, [] { return 4; });
+      std::cout << three << ',' << four << '\n';
+
+      int const limit = bench ? 2'000'000 : 20'000;
+      run_stages("sequential", sequential, limit);
+      run_stages("parallel", parallel, limit);
+   }
+
+   {
+      using namespace n328;
+
+      constexpr int threads = 4;
+      int const increments = bench ? 10'000'000 : 100'000;
+
+      std::array<std::atomic<long>, threads> packed{};
+      count_in_threads("packed counters", threads, increments, packed,
+         [](auto& c, int t) { c[t].fetch_add(1, std::memory_order_relaxed); });
+
+      std::array<cache_padded<std::atomic<long>>, threads> padded{};
+      count_in_threads("padded counters", threads, increments, padded,
+         [](auto& c, int t) { c[t]->fetch_add(1, std::memory_order_relaxed); });
+
+      per_thread<std::atomic<long>> counter;
+      count_in_threads("per_thread counter", threads, increments, counter,
+         [](auto& c, int) { c.local().fetch_add(1, std::memory_order_relaxed); });
+
+      std::cout << sizeof(packed) << ',' << sizeof(padded) << ','
+                << counter.combine(0L, [](long sum, auto const& c) { return sum + c.load(); })
+                << '\n';
+   }
+
+   {
+      using namespace n329;
+
+      std::cout << sum_of(naive{}, 1e16, 1.0, -1e16) << ','
+                << sum_of(neumaier{}, 1e16, 1.0, -1e16) << '\n';   // 0,1
+
+      sum_wrapper<neumaier, double, double, double> sw(1e16, 1.0, -1e16);
+      std::cout << sw.value << '\n';
+
+      std::vector<double> values(bench ? 10'000'000 : 100'000);
+      std::mt19937_64 gen(42);
+      std::uniform_real_distribution<double> mantissa(1.0, 2.0);
+      std::uniform_int_distribution<int> exponent(-20, 20);
+      for (auto& v : values)
+         v = std::ldexp(mantissa(gen), exponent(gen));
+
+      std::vector<long double> extended(values.begin(), values.end());
+      long double exact = sum(neumaier{}, extended);
+
+      report("naive", values.size(), exact, [&] { return sum(naive{}, values); });
+      report("naive long double", values.size(), exact, [&] {
+         long double total = 0;
+         for (double v : values)
+            total += v;
+         return total;
+      });
+      report("pairwise", values.size(), exact, [&] { return sum(pairwise{}, values); });
+      report("neumaier", values.size(), exact, [&] { return sum(neumaier{}, values); });
+   }
+
+   {
+      using namespace n330;
+
+      auto twice_then_ratio =
+         compose([](int a, int b) { return n312::twice_as(a, b); })
+         | [](bool twice) { return twice ? 1 : 2; }
+         | [](int b) { return n312::sum_and_div(42, b, 10.0); };
+      std::cout << twice_then_ratio(42, 12) << ',' << twice_then_ratio(42, 30) << '\n';
+
+      auto pass_through = compose([](int x) { return x + 1; })
+         | [](int const& x) -> int const& { return x; };
+      std::cout << pass_through(41) << '\n';
+
+      auto scale  = [](double x) { return x * 1.5; };
+      auto shift  = [](double x) { return x + 2.0; };
+      auto square = [](double x) { return x * x; };
+      auto lower  = [](double x) { return x - 1.0; };
+      auto divide = [](double x) { return x / 3.0; };
+
+      auto pipeline = compose(scale, shift) | compose(square, lower) | divide;
+
+      std::vector<std::function<double(double)>> chain{ scale, shift, square, lower, divide };
+
+      std::vector<double> in(bench ? 10'000'000 : 100'000), out(in.size());
+      for (std::size_t i = 0; i < in.size(); ++i)
+         in[i] = (i % 1000) * 0.001;
+
+      constexpr int passes = 10;   // 100M elements in total with --bench
+
+      double ms = timing::milliseconds([&] {
+         for (int p = 0; p < passes; ++p)
+            for (std::size_t i = 0; i < in.size(); ++i)
+            {
+               double x = in[i];
+               for (auto const& f : chain)
+                  x = f(x);
+               out[i] = x;
+            }
+      });
+      std::cout << "std::function chain: " << ms << " ms, last=" << out.back() << '\n';
+
+      ms = timing::milliseconds([&] {
+         for (int p = 0; p < passes; ++p)
+            apply(pipeline, std::span<double const>(in), std::span<double>(out));
+      });
+      std::cout << "composed pipeline: " << ms << " ms, last=" << out.back() << '\n';
    }
 }
\ No newline at end of file
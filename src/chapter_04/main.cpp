@@ -2,7 +2,49 @@
 #include <vector>
 #include <mutex>
 #include <string>
+#include <string_view>
 #include <map>
+#include <array>
+#include <optional>
+#include <span>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <chrono>
+#include <random>
+#include <unordered_map>
+#include <algorithm>
+#include <numeric>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
+#include <filesystem>
+#include <set>
+#include <bit>
+#include <charconv>
+#include <fstream>
+#include <utility>
+#include <cstring>
+#include <deque>
+#include <iterator>
+#include <ranges>
+#include <memory_resource>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
 
 namespace n401
 {
@@ -501,12 +543,32 @@ namespace n418
 
    template <typename T, typename... Ts, typename Allocator = std::allocator<T>>
    auto make_vector(T&& first, Ts&&... args)
+      requires (!std::is_same_v<std::decay_t<T>, std::allocator_arg_t>)
    {
       return std::vector<std::decay_t<T>, Allocator> {
          std::forward<T>(first),
          std::forward<Ts>(args)... 
       };
    }
+
+   // the elements are allocated with alloc, rebound to their type
+   template <typename Allocator, typename T, typename... Ts>
+   auto make_vector(std::allocator_arg_t, Allocator const& alloc, T&& first, Ts&&... args)
+   {
+      using value_type = std::decay_t<T>;
+      using allocator_type =
+         typename std::allocator_traits<Allocator>::template rebind_alloc<value_type>;
+      return std::vector<value_type, allocator_type>(
+         { std::forward<T>(first), std::forward<Ts>(args)... },
+         allocator_type(alloc));
+   }
+
+   template <template <typename> class Allocator, typename T, typename... Ts>
+   auto make_vector(T&& first, Ts&&... args)
+   {
+      return make_vector(std::allocator_arg, Allocator<std::decay_t<T>>(),
+                         std::forward<T>(first), std::forward<Ts>(args)...);
+   }
 }
 
 namespace n419
@@ -524,20 +586,97 @@ namespace n419
 
 namespace n420
 {
+   enum class ownership { owned, borrowed };
+
+   // asks for a range that refers to the elements of a contiguous range
+   // instead of copying them; the caller guarantees they outlive it
+   struct borrow_t { explicit borrow_t() = default; };
+   inline constexpr borrow_t borrow{};
+
+   template <typename T, ownership O, typename Allocator>
+   struct range_t;
+
    template <typename T>
+   constexpr bool is_range_t = false;
+
+   template <typename T, ownership O, typename Allocator>
+   constexpr bool is_range_t<range_t<T, O, Allocator>> = true;
+
+   // a range other than range_t itself, which is copied and moved as usual
+   template <typename R>
+   concept source_range = std::ranges::input_range<R> && !is_range_t<std::remove_cvref_t<R>>;
+
+   template <typename T, ownership O = ownership::owned,
+             typename Allocator = std::allocator<T>>
    struct range_t
    {
+      using storage_type = std::conditional_t<O == ownership::owned,
+                                              std::vector<T, Allocator>, std::span<T const>>;
+
       template <typename Iter>
-      range_t(Iter first, Iter last)
+      range_t(Iter first, Iter last, Allocator const& alloc = Allocator())
+         requires (O == ownership::owned)
+         : data(alloc)
       {
-         std::copy(first, last, std::back_inserter(data));
+         // assign allocates once for forward iterators, and copies a
+         // contiguous range of trivially copyable elements as one block
+         if constexpr (std::forward_iterator<Iter>)
+         {
+            data.assign(first, last);
+         }
+         else
+         {
+            if constexpr (std::sized_sentinel_for<Iter, Iter>)
+               data.reserve(static_cast<std::size_t>(last - first));
+            std::copy(first, last, std::back_inserter(data));
+         }
       }
+
+      range_t(std::vector<T, Allocator>&& v) requires (O == ownership::owned)
+         : data(std::move(v))
+      {}
+
+      template <source_range R>
+      range_t(R&& r, Allocator const& alloc = Allocator()) requires (O == ownership::owned)
+         : range_t(std::ranges::begin(r), std::ranges::end(r), alloc)
+      {}
+
+      // refers to the elements of r, which must outlive the range
+      template <source_range R>
+      range_t(borrow_t, R& r) requires (O == ownership::borrowed && std::ranges::contiguous_range<R>)
+         : data(std::ranges::data(r), std::ranges::size(r))
+      {}
+
+      auto begin() const { return data.begin(); }
+      auto end() const { return data.end(); }
+      std::size_t size() const { return data.size(); }
    private:
-      std::vector<T> data;
+      storage_type data;
    };
 
    template <typename Iter>
    range_t(Iter first, Iter last) -> range_t<typename std::iterator_traits<Iter>::value_type>;
+
+   template <typename Iter, typename Allocator>
+   range_t(Iter first, Iter last, Allocator alloc)
+      -> range_t<typename std::iterator_traits<Iter>::value_type, ownership::owned, Allocator>;
+
+   // a vector passed as an rvalue is taken over, with its allocator
+   template <typename T, typename Allocator>
+   range_t(std::vector<T, Allocator>&& v) -> range_t<T, ownership::owned, Allocator>;
+
+   // a deduction guide cannot know whether r outlives the range, so any
+   // range is copied unless borrowing is asked for with the borrow tag
+   template <source_range R>
+   range_t(R&& r) -> range_t<std::ranges::range_value_t<R>>;
+
+   template <source_range R>
+      requires std::ranges::contiguous_range<R>
+   range_t(borrow_t, R& r) -> range_t<std::ranges::range_value_t<R>, ownership::borrowed>;
+
+   template <source_range R, typename Allocator>
+   range_t(R&& r, Allocator alloc)
+      -> range_t<std::ranges::range_value_t<R>, ownership::owned, Allocator>;
 }
 
 namespace n421
@@ -976,148 +1115,2314 @@ namespace n442
       friend struct printer<int>;
    };
 
-   template <typename T>
-   void print(wrapper<T> const& w)
+   template <typename T>
+   void print(wrapper<T> const& w)
+   {
+      // std::cout << w.value << '\n'; // error
+   }
+
+   template<>
+   void print(wrapper<int> const& w)
+   {
+      std::cout << w.value << '\n';
+   }
+
+   template <typename T>
+   struct printer
+   {
+      void operator()(wrapper<T> const& w)
+      {
+         //std::cout << w.value << '\n'; // error
+      }
+   };
+
+   template <>
+   struct printer<int>
+   {
+      void operator()(wrapper<int> const& w)
+      {
+         std::cout << w.value << '\n';
+      }
+   };
+}
+
+namespace n443
+{
+   template <typename T>
+   struct printer;
+
+   template <typename T>
+   struct wrapper
+   {
+      wrapper(T const v) :value(v) {}
+   private:
+      T value;
+
+      template <typename U>
+      friend void print(wrapper<U> const&);
+
+      template <typename U>
+      friend struct printer;
+   };
+
+   template <typename T>
+   void print(wrapper<T> const& w)
+   {
+      std::cout << w.value << '\n';
+   }
+
+   template <typename T>
+   struct printer
+   {
+      void operator()(wrapper<T> const& w)
+      {
+         std::cout << w.value << '\n';
+      }
+   };
+}
+
+namespace n444
+{
+   template <typename T>
+   struct printer;
+
+   template <typename T>
+   struct wrapper
+   {
+      wrapper(T const v) :value(v) {}
+   private:
+      T value;
+
+      friend void print<T>(wrapper<T> const&);
+      friend struct printer<T>;
+   };
+
+   template <typename T>
+   void print(wrapper<T> const& w)
+   {
+      std::cout << w.value << '\n';
+   }
+
+   template <typename T>
+   struct printer
+   {
+      void operator()(wrapper<T> const& w)
+      {
+         std::cout << w.value << '\n';
+      }
+   };
+}
+
+namespace n445
+{
+   template <typename T>
+   struct connection
+   {
+      connection(std::string const& host, int const port) 
+         :ConnectionString(host + ":" + std::to_string(port)) 
+      {}
+   private:
+      std::string ConnectionString;
+      friend T;
+   };
+
+   struct executor
+   {
+      void run()
+      {
+         connection<executor> c("localhost", 1234);
+         
+         std::cout << c.ConnectionString << '\n';
+      }
+   };
+}
+
+namespace n446
+{
+   struct dictionary_traits
+   {
+      using key_type = int;
+      using map_type = std::map<key_type, std::string>;
+      static constexpr int identity = 1;
+   };
+
+   // a vector with the value for key k at position k - Identity
+   template <typename Key, typename Value, Key Identity>
+   class dense_map
+   {
+   public:
+      using key_type = Key;
+      using mapped_type = Value;
+      using value_type = std::pair<Key, Value>;
+      using const_iterator = typename std::vector<value_type>::const_iterator;
+
+      void reserve(std::size_t const n)
+      {
+         slots.reserve(n);
+         present.reserve(n);
+      }
+
+      void insert_or_assign(Key const& key, Value const& value)
+      {
+         if (key < Identity)
+            throw std::out_of_range("key below the identity of a dense_map");
+         auto const index = static_cast<std::size_t>(key - Identity);
+         if (index >= slots.size())
+         {
+            slots.resize(index + 1);
+            present.resize(index + 1);
+         }
+         if (!present[index])
+         {
+            present[index] = true;
+            slots[index].first = key;
+            ++count;
+         }
+         slots[index].second = value;
+      }
+
+      const_iterator find(Key const& key) const
+      {
+         if (key < Identity)
+            return end();
+         auto const index = static_cast<std::size_t>(key - Identity);
+         return index < slots.size() && present[index] ? slots.begin() + index : end();
+      }
+
+      const_iterator end() const { return slots.end(); }
+      std::size_t size() const noexcept { return count; }
+
+   private:
+      std::vector<value_type> slots;
+      std::vector<bool>       present;
+      std::size_t             count = 0;
+   };
+
+   // a vector of pairs sorted by key; keys larger than all the others are
+   // appended, any other new key is inserted in place
+   template <typename Key, typename Value>
+   class flat_map
+   {
+   public:
+      using key_type = Key;
+      using mapped_type = Value;
+      using value_type = std::pair<Key, Value>;
+      using const_iterator = typename std::vector<value_type>::const_iterator;
+
+      void reserve(std::size_t const n) { data.reserve(n); }
+
+      void insert_or_assign(Key const& key, Value const& value)
+      {
+         if (data.empty() || data.back().first < key)
+         {
+            data.emplace_back(key, value);
+            return;
+         }
+         auto it = std::lower_bound(data.begin(), data.end(), key,
+                                    [](value_type const& e, Key const& k) { return e.first < k; });
+         if (it != data.end() && it->first == key)
+            it->second = value;
+         else
+            data.emplace(it, key, value);
+      }
+
+      const_iterator find(Key const& key) const
+      {
+         auto it = std::lower_bound(data.begin(), data.end(), key,
+                                    [](value_type const& e, Key const& k) { return e.first < k; });
+         return it != data.end() && it->first == key ? it : end();
+      }
+
+      const_iterator end() const { return data.end(); }
+      std::size_t size() const noexcept { return data.size(); }
+
+   private:
+      std::vector<value_type> data;
+   };
+
+   // an open-addressing hash table with linear probing, kept at most half full
+   template <typename Key, typename Value, typename Hash = std::hash<Key>>
+   class open_hash_map
+   {
+   public:
+      using key_type = Key;
+      using mapped_type = Value;
+      using value_type = std::pair<Key, Value>;
+      using const_iterator = typename std::vector<value_type>::const_iterator;
+
+      void reserve(std::size_t const n)
+      {
+         if (n * 2 > slots.size())
+            rehash(std::bit_ceil(n * 2));
+      }
+
+      void insert_or_assign(Key const& key, Value const& value)
+      {
+         if ((count + 1) * 2 > slots.size())
+            rehash(std::max<std::size_t>(16, slots.size() * 2));
+         std::size_t const i = probe(key);
+         if (!used[i])
+         {
+            used[i] = 1;
+            slots[i].first = key;
+            ++count;
+         }
+         slots[i].second = value;
+      }
+
+      const_iterator find(Key const& key) const
+      {
+         if (slots.empty())
+            return end();
+         std::size_t const i = probe(key);
+         return used[i] ? slots.begin() + i : end();
+      }
+
+      const_iterator end() const { return slots.end(); }
+      std::size_t size() const noexcept { return count; }
+
+   private:
+      // Fibonacci hashing, so that sequential keys are spread over the table
+      std::size_t probe(Key const& key) const
+      {
+         std::size_t const mask = slots.size() - 1;
+         std::size_t i = static_cast<std::size_t>(
+            (static_cast<std::uint64_t>(Hash{}(key)) * 0x9E3779B97F4A7C15ull) >> shift);
+         while (used[i] && !(slots[i].first == key))
+            i = (i + 1) & mask;
+         return i;
+      }
+
+      void rehash(std::size_t const capacity)
+      {
+         std::vector<value_type> old_slots(capacity);
+         std::vector<std::uint8_t> old_used(capacity);
+         old_slots.swap(slots);
+         old_used.swap(used);
+         shift = 64 - std::countr_zero(capacity);
+         for (std::size_t i = 0; i < old_slots.size(); ++i)
+         {
+            if (old_used[i])
+            {
+               std::size_t const j = probe(old_slots[i].first);
+               used[j] = 1;
+               slots[j] = std::move(old_slots[i]);
+            }
+         }
+      }
+
+      std::vector<value_type>   slots;
+      std::vector<std::uint8_t> used;
+      std::size_t               count = 0;
+      unsigned                  shift = 64;
+   };
+
+   struct dense_dictionary_traits
+   {
+      using key_type = int;
+      static constexpr int identity = 1;
+      using map_type = dense_map<key_type, std::string, identity>;
+   };
+
+   struct flat_dictionary_traits
+   {
+      using key_type = int;
+      using map_type = flat_map<key_type, std::string>;
+      static constexpr int identity = 1;
+   };
+
+   struct hash_dictionary_traits
+   {
+      using key_type = int;
+      using map_type = open_hash_map<key_type, std::string>;
+      static constexpr int identity = 1;
+   };
+
+   template <typename T>
+   struct dictionary : T::map_type
+   {
+      int start_key{ T::identity };
+      T::key_type next_key{ T::identity };
+
+      using value_type = T::map_type::mapped_type;
+
+      void add(T::key_type const& key, value_type const& value)
+      {
+         this->insert_or_assign(key, value);
+         if (!(key < next_key))
+            next_key = key + 1;
+      }
+
+      // adds the value under the next key, and returns that key
+      T::key_type add(value_type const& value)
+      {
+         auto const key = next_key;
+         add(key, value);
+         return key;
+      }
+
+      value_type const* get(T::key_type const& key) const
+      {
+         auto it = this->find(key);
+         return it == this->end() ? nullptr : &it->second;
+      }
+   };
+
+   template <typename T>
+   void measure(char const* name, std::vector<int> const& keys)
+   {
+      auto start = std::chrono::steady_clock::now();
+      dictionary<T> d;
+      if constexpr (requires { d.reserve(keys.size()); })
+         d.reserve(keys.size());
+      for (int const key : keys)
+         d.add(key, std::to_string(key));
+      auto middle = std::chrono::steady_clock::now();
+
+      std::size_t found = 0;
+      for (int const key : keys)
+         found += d.get(key) != nullptr;
+      auto end = std::chrono::steady_clock::now();
+
+      auto per_key = [&keys](auto from, auto to) {
+         return std::chrono::duration<double, std::nano>(to - from).count() / keys.size();
+      };
+      std::cout << name << ": insert " << per_key(start, middle) << "ns, lookup "
+                << per_key(middle, end) << "ns per key (" << found << " found)\n";
+   }
+}
+
+namespace n447
+{
+   // evaluates F for i = 0, 1, ... at compile time and stores the values;
+   // F gets the values computed so far, so recurrences are O(N), and it
+   // returns std::nullopt where the value no longer fits, which ends the table
+   template <typename F, std::size_t N>
+   struct table
+   {
+      using value_type = typename F::value_type;
+
+   private:
+      struct storage
+      {
+         std::array<value_type, N> values{};
+         std::size_t               size = 0;
+      };
+
+      static constexpr storage data = []{
+         storage s;
+         for (; s.size < N; ++s.size)
+         {
+            std::optional<value_type> v = F{}(s.size, std::span<value_type const>(s.values.data(), s.size));
+            if (!v)
+               break;
+            s.values[s.size] = *v;
+         }
+         return s;
+      }();
+
+   public:
+      static constexpr std::size_t size = data.size;
+
+      static constexpr value_type at(std::size_t const i)
+      {
+         if (i >= size)
+            throw std::out_of_range("table index out of range");
+         return data.values[i];
+      }
+
+      template <std::size_t I>
+      static constexpr value_type get()
+      {
+         static_assert(I < size, "table index out of range");
+         return data.values[I];
+      }
+   };
+
+   struct factorial_fn
+   {
+      using value_type = std::uint64_t;
+
+      constexpr std::optional<value_type> operator()(std::size_t const n,
+                                                     std::span<value_type const> prev) const
+      {
+         if (n == 0)
+            return 1;
+         if (prev[n - 1] > std::numeric_limits<value_type>::max() / n)
+            return std::nullopt;
+         return prev[n - 1] * n;
+      }
+   };
+
+   using factorial_table = table<factorial_fn, 64>;
+
+   static_assert(factorial_table::size == 21);   // 20! is the last one in 64 bits
+   static_assert(factorial_table::get<5>() == 120);
+
+   // n411::sum: 0 + 1 + ... + n
+   struct cumulative_sum_fn
+   {
+      using value_type = std::uint64_t;
+
+      constexpr std::optional<value_type> operator()(std::size_t const n,
+                                                     std::span<value_type const> prev) const
+      {
+         return n == 0 ? 0 : prev[n - 1] + n;
+      }
+   };
+
+   using cumulative_sum_table = table<cumulative_sum_fn, 1024>;
+
+   static_assert(cumulative_sum_table::get<256>() == 32896);
+
+   // Pascal's triangle stored row by row; C(n, k) is at n * (n + 1) / 2 + k.
+   // Coefficients that do not fit are stored as overflow instead of ending
+   // the table, since the edges of later rows are still small
+   struct binomial_fn
+   {
+      using value_type = std::uint64_t;
+
+      static constexpr value_type overflow = 0;   // no coefficient is 0
+
+      constexpr std::optional<value_type> operator()(std::size_t const i,
+                                                     std::span<value_type const> prev) const
+      {
+         std::size_t n = 0;
+         while ((n + 1) * (n + 2) / 2 <= i)
+            ++n;
+         std::size_t k = i - n * (n + 1) / 2;
+         if (k == 0 || k == n)
+            return 1;
+
+         value_type a = prev[index(n - 1, k - 1)];
+         value_type b = prev[index(n - 1, k)];
+         if (a == overflow || b == overflow || a > std::numeric_limits<value_type>::max() - b)
+            return overflow;
+         return a + b;
+      }
+
+      static constexpr std::size_t index(std::size_t const n, std::size_t const k)
+      {
+         return n * (n + 1) / 2 + k;
+      }
+   };
+
+   using binomial_table = table<binomial_fn, 80 * 81 / 2>;
+
+   constexpr std::uint64_t binomial(std::size_t const n, std::size_t const k)
+   {
+      if (k > n)
+         return 0;
+      std::uint64_t const value = binomial_table::at(binomial_fn::index(n, k));
+      if (value == binomial_fn::overflow)
+         throw std::overflow_error("binomial coefficient does not fit");
+      return value;
+   }
+
+   static_assert(binomial(5, 2) == 10);
+   static_assert(binomial(67, 33) == 14226520737620288370ull);
+   static_assert(binomial(70, 2) == 2415);
+   static_assert(binomial(79, 79) == 1);
+
+   template <typename F>
+   void measure(char const* name, std::vector<unsigned> const& indexes, F&& f)
+   {
+      auto start = std::chrono::steady_clock::now();
+      std::uint64_t total = 0;
+      for (auto i : indexes)
+         total += f(i);
+      auto end = std::chrono::steady_clock::now();
+
+      std::cout << name << ": "
+                << std::chrono::duration<double, std::milli>(end - start).count()
+                << " ms, total=" << total << '\n';
+   }
+}
+
+namespace n448
+{
+   struct transaction
+   {
+      int    account;   // account number
+      double amount;    // negative for a withdrawal
+   };
+
+   // the balance_t operations over many accounts, with account numbers and
+   // amounts kept in separate columns and a hash index from number to row
+   class ledger
+   {
+   public:
+      void reserve(std::size_t const n)
+      {
+         numbers.reserve(n);
+         amounts.reserve(n);
+         index.reserve(n);
+      }
+
+      bool open(n412::account_t const account, double const amount = 0)
+      {
+         auto [it, inserted] = index.try_emplace(account.number, numbers.size());
+         if (inserted)
+         {
+            numbers.push_back(account.number);
+            amounts.push_back(amount);
+         }
+         return inserted;
+      }
+
+      // opens an account for every row of the two columns, and returns
+      // how many of them were not open already
+      std::size_t open_all(std::span<int const> numbers, std::span<double const> amounts)
+      {
+         std::size_t opened = 0;
+         for (std::size_t i = 0; i < numbers.size() && i < amounts.size(); ++i)
+            opened += open(n412::account_t{ numbers[i] }, amounts[i]);
+         return opened;
+      }
+
+      std::size_t size() const noexcept { return numbers.size(); }
+
+      std::optional<double> balance(int const number) const
+      {
+         auto it = index.find(number);
+         if (it == index.end())
+            return std::nullopt;
+         return amounts[it->second];
+      }
+
+      // result[i] is whether batch[i] could be applied on its own
+      void can_withdraw(std::span<transaction const> batch, std::span<bool> result) const
+      {
+         std::vector<double> current(batch.size());
+         for (std::size_t i = 0; i < batch.size(); ++i)
+         {
+            auto it = index.find(batch[i].account);
+            current[i] = it == index.end() ? -std::numeric_limits<double>::infinity()
+                                           : amounts[it->second];
+         }
+
+         // a plain loop over contiguous arrays, which the compiler vectorizes
+         for (std::size_t i = 0; i < batch.size(); ++i)
+            result[i] = current[i] + batch[i].amount >= 0;
+      }
+
+      // applies the batch in order, so transactions for the same account
+      // keep their order; withdrawals that would overdraw the account or
+      // refer to unknown accounts are skipped
+      std::size_t apply_transactions(std::span<transaction const> batch)
+      {
+         std::size_t applied = 0;
+         for (auto const& t : batch)
+         {
+            auto it = index.find(t.account);
+            if (it == index.end())
+               continue;
+            double& balance = amounts[it->second];
+            if (t.amount >= 0 || balance >= -t.amount)
+            {
+               balance += t.amount;
+               ++applied;
+            }
+         }
+         return applied;
+      }
+
+   private:
+      std::vector<int>                     numbers;
+      std::vector<double>                  amounts;
+      std::unordered_map<int, std::size_t> index;
+   };
+}
+
+namespace n449
+{
+   // amounts are kept as whole cents so that they can be updated atomically
+   using cents = std::int64_t;
+
+   constexpr cents to_cents(double const amount)
+   {
+      return static_cast<cents>(amount * 100 + (amount < 0 ? -0.5 : 0.5));
+   }
+
+   constexpr double to_amount(cents const value)
+   {
+      return value / 100.0;
+   }
+
+   class atomic_balance
+   {
+   public:
+      explicit atomic_balance(cents const initial = 0) : value(initial) {}
+
+      // only positive amounts are accepted; a negative deposit would be a
+      // withdrawal that skips the funds check
+      bool deposit(cents const amount)
+      {
+         if (amount <= 0)
+            return false;
+         value.fetch_add(amount, std::memory_order_acq_rel);
+         return true;
+      }
+
+      // the check and the update are one compare-and-swap, so there is no
+      // window between can_withdraw and withdraw for another thread to use
+      std::optional<n412::transaction_t> try_withdraw(cents const amount)
+      {
+         if (amount <= 0)
+            return std::nullopt;
+         cents current = value.load(std::memory_order_relaxed);
+         do
+         {
+            if (current < amount)
+               return std::nullopt;
+         } while (!value.compare_exchange_weak(current, current - amount,
+                                               std::memory_order_acq_rel,
+                                               std::memory_order_relaxed));
+         return n412::transaction_t{ -to_amount(amount) };
+      }
+
+      // takes as much of amount as is available, and returns how much that was
+      cents take_up_to(cents const amount)
+      {
+         cents current = value.load(std::memory_order_relaxed);
+         cents taken = 0;
+         do
+         {
+            taken = std::min(current, amount);
+            if (taken <= 0)
+               return 0;
+         } while (!value.compare_exchange_weak(current, current - taken,
+                                               std::memory_order_acq_rel,
+                                               std::memory_order_relaxed));
+         return taken;
+      }
+
+      cents get() const { return value.load(std::memory_order_acquire); }
+
+   private:
+      std::atomic<cents> value;
+   };
+
+   inline std::size_t thread_slot()
+   {
+      static std::atomic<std::size_t> next{ 0 };
+      thread_local std::size_t slot = next.fetch_add(1, std::memory_order_relaxed);
+      return slot;
+   }
+
+   // a hot account split over several cache lines; each thread starts with
+   // its own shard and only touches the others when that one runs short.
+   // A withdrawal that its own shard cannot cover collects from the other
+   // shards one at a time and puts the money back if the total is not
+   // enough, so while it runs, a concurrent withdrawal can be refused even
+   // though the account as a whole holds enough; no money is lost or created
+   template <std::size_t Shards = 16>
+   class sharded_balance
+   {
+   public:
+      explicit sharded_balance(cents const initial = 0)
+      {
+         shards[0].balance.deposit(initial);
+      }
+
+      bool deposit(cents const amount)
+      {
+         return shards[thread_slot() % Shards].balance.deposit(amount);
+      }
+
+      // either takes the whole amount, possibly from several shards, or
+      // leaves the total unchanged
+      std::optional<n412::transaction_t> try_withdraw(cents const amount)
+      {
+         if (amount <= 0)
+            return std::nullopt;
+         std::size_t const first = thread_slot() % Shards;
+         if (shards[first].balance.try_withdraw(amount))
+            return n412::transaction_t{ -to_amount(amount) };
+
+         cents needed = amount;
+         for (std::size_t i = 0; i < Shards && needed > 0; ++i)
+            needed -= shards[(first + i) % Shards].balance.take_up_to(needed);
+
+         if (needed == 0)
+            return n412::transaction_t{ -to_amount(amount) };
+
+         shards[first].balance.deposit(amount - needed);
+         return std::nullopt;
+      }
+
+      // exact only while no operation is in progress
+      cents get() const
+      {
+         cents total = 0;
+         for (auto const& s : shards)
+            total += s.balance.get();
+         return total;
+      }
+
+   private:
+      struct alignas(64) shard
+      {
+         atomic_balance balance;
+      };
+
+      std::array<shard, Shards> shards;
+   };
+
+   // threads move random amounts between a few hot accounts; the total
+   // must be the same at the end
+   template <typename Balance>
+   void stress(char const* name, int const threads, int const operations)
+   {
+      constexpr int hot = 4;
+      constexpr cents initial = to_cents(1000.0);
+      auto accounts = std::make_unique<Balance[]>(hot);
+      for (int i = 0; i < hot; ++i)
+         accounts[i].deposit(initial);
+
+      std::atomic<long> succeeded{ 0 };
+      auto start = std::chrono::steady_clock::now();
+      std::vector<std::thread> workers;
+      for (int t = 0; t < threads; ++t)
+         workers.emplace_back([&, t] {
+            std::mt19937 gen(t);
+            std::uniform_int_distribution<int> account(0, hot - 1);
+            std::uniform_int_distribution<cents> amount(1, to_cents(100.0));
+            long ok = 0;
+            for (int i = 0; i < operations; ++i)
+            {
+               cents const value = amount(gen);
+               if (accounts[account(gen)].try_withdraw(value))
+               {
+                  accounts[account(gen)].deposit(value);
+                  ++ok;
+               }
+            }
+            succeeded += ok;
+         });
+      for (auto& w : workers)
+         w.join();
+      auto end = std::chrono::steady_clock::now();
+
+      cents total = 0;
+      for (int i = 0; i < hot; ++i)
+         total += accounts[i].get();
+
+      double seconds = std::chrono::duration<double>(end - start).count();
+      std::cout << name << ": " << succeeded << " transfers, "
+                << threads * double(operations) / seconds / 1e6 << " M op/s, money "
+                << (total == hot * initial ? "conserved" : "NOT conserved") << '\n';
+   }
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+namespace n450
+{
+   // one fixed-size journal entry; a slot is valid once its sequence number
+   // (slot index + 1) and checksum are in place
+   struct journal_record
+   {
+      std::uint64_t sequence;
+      std::int64_t  cents;
+      std::int32_t  account;
+      std::uint32_t reserved;
+      std::uint64_t checksum;
+   };
+
+   static_assert(sizeof(journal_record) == 32);
+
+   constexpr std::uint64_t checksum(journal_record const& r)
+   {
+      std::uint64_t h = 14695981039346656037ull;
+      for (std::uint64_t v : { r.sequence, static_cast<std::uint64_t>(r.cents),
+                               static_cast<std::uint64_t>(static_cast<std::uint32_t>(r.account)) })
+      {
+         h ^= v;
+         h *= 1099511628211ull;
+      }
+      return h;
+   }
+
+   struct group_commit
+   {
+      std::size_t               records = 64;   // sync once this many are pending
+      std::chrono::microseconds delay{ 1000 };  // or once the oldest waited this long
+   };
+
+   // append-only journal of transactions in a memory-mapped file; writers
+   // reserve slots with an atomic counter and a background thread makes
+   // the written prefix durable in groups
+   class journal
+   {
+   public:
+      journal(std::filesystem::path const& path, std::size_t const capacity,
+              group_commit const policy = {})
+         : capacity(capacity), policy(policy)
+      {
+         fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+         if (fd < 0)
+            throw std::runtime_error("cannot open journal " + path.string());
+
+         std::size_t const bytes = capacity * sizeof(journal_record);
+         struct stat st{};
+         if (::fstat(fd, &st) != 0 ||
+             (static_cast<std::size_t>(st.st_size) < bytes && ::ftruncate(fd, bytes) != 0))
+         {
+            ::close(fd);
+            throw std::runtime_error("cannot size journal " + path.string());
+         }
+
+         void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+         if (p == MAP_FAILED)
+         {
+            ::close(fd);
+            throw std::runtime_error("cannot map journal " + path.string());
+         }
+         records = static_cast<journal_record*>(p);
+
+         // continue after the last valid record left by a previous run
+         std::size_t end = 0;
+         while (end < capacity && valid(records[end], end))
+            ++end;
+         next = end;
+         durable = end;
+
+         // a torn record ends the prefix, but records after it from the
+         // previous run may still be valid; clear them, durably, before
+         // anything is appended, or the prefix would take them back in
+         // once new records reach them
+         std::size_t stale = capacity;
+         while (stale > end && records[stale - 1].sequence == 0)
+            --stale;
+         if (stale > end)
+         {
+            std::memset(static_cast<void*>(records + end), 0, (stale - end) * sizeof(journal_record));
+            sync(end, stale);
+         }
+
+         committer = std::thread([this] { commit_loop(); });
+      }
+
+      journal(journal const&) = delete;
+      journal& operator=(journal const&) = delete;
+
+      ~journal()
+      {
+         {
+            std::lock_guard lock(mt);
+            stopping = true;
+         }
+         commit_cv.notify_one();
+         committer.join();
+         ::munmap(records, capacity * sizeof(journal_record));
+         ::close(fd);
+      }
+
+      // returns the sequence number of the record, or nullopt if the journal is full
+      std::optional<std::uint64_t> append(int const account, n412::transaction_t const t)
+      {
+         std::size_t const slot = next.fetch_add(1, std::memory_order_relaxed);
+         if (slot >= capacity)
+            return std::nullopt;
+
+         journal_record& r = records[slot];
+         r.cents = n449::to_cents(t.amount);
+         r.account = account;
+         r.reserved = 0;
+         std::uint64_t const sequence = slot + 1;
+         journal_record copy = r;
+         copy.sequence = sequence;
+         r.checksum = checksum(copy);
+         // publishing the sequence number last marks the record complete
+         std::atomic_ref<std::uint64_t>(r.sequence).store(sequence, std::memory_order_release);
+
+         if (slot + 1 - durable.load(std::memory_order_relaxed) >= policy.records)
+            commit_cv.notify_one();
+         return sequence;
+      }
+
+      // blocks until the record with this sequence number is on disk
+      void wait_durable(std::uint64_t const sequence)
+      {
+         if (durable.load(std::memory_order_acquire) >= sequence)
+            return;
+         std::unique_lock lock(mt);
+         durable_cv.wait(lock, [&] {
+            return durable.load(std::memory_order_acquire) >= sequence || stopping;
+         });
+      }
+
+      std::uint64_t syncs() const { return sync_count.load(); }
+
+   private:
+      static bool valid(journal_record const& r, std::size_t const slot)
+      {
+         return r.sequence == slot + 1 && r.checksum == checksum(r);
+      }
+
+      void commit_loop()
+      {
+         std::unique_lock lock(mt);
+         for (;;)
+         {
+            commit_cv.wait_for(lock, policy.delay, [this] {
+               return stopping ||
+                  std::min(next.load(), capacity) - durable.load() >= policy.records;
+            });
+            bool const last = stopping;
+
+            // the published prefix; a slot that is reserved but not yet
+            // written ends it
+            std::size_t const from = durable.load();
+            std::size_t to = from;
+            std::size_t const reserved = std::min(next.load(), capacity);
+            while (to < reserved &&
+                   std::atomic_ref<std::uint64_t>(records[to].sequence).load(std::memory_order_acquire) == to + 1)
+               ++to;
+
+            if (to > from)
+            {
+               lock.unlock();
+               sync(from, to);
+               lock.lock();
+               durable.store(to, std::memory_order_release);
+               durable_cv.notify_all();
+            }
+
+            if (last)
+               return;
+         }
+      }
+
+      void sync(std::size_t const from, std::size_t const to)
+      {
+         static std::size_t const page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+         std::size_t const begin = from * sizeof(journal_record) / page * page;
+         std::size_t const end = to * sizeof(journal_record);
+         ::msync(reinterpret_cast<char*>(records) + begin, end - begin, MS_SYNC);
+         ++sync_count;
+      }
+
+      int                        fd = -1;
+      journal_record*            records = nullptr;
+      std::size_t                capacity;
+      group_commit               policy;
+      std::atomic<std::size_t>   next{ 0 };
+      std::atomic<std::size_t>   durable{ 0 };
+      std::atomic<std::uint64_t> sync_count{ 0 };
+      std::mutex                 mt;
+      std::condition_variable    commit_cv;
+      std::condition_variable    durable_cv;
+      bool                       stopping = false;
+      std::thread                committer;
+   };
+
+   // calls apply(account, transaction) for every record of the valid
+   // prefix, the same records a journal opened on the file keeps, and
+   // returns how many there were
+   template <typename F>
+   std::size_t replay(std::filesystem::path const& path, F&& apply)
+   {
+      int fd = ::open(path.c_str(), O_RDONLY);
+      if (fd < 0)
+         return 0;
+
+      std::size_t count = 0;
+      journal_record r{};
+      while (::read(fd, &r, sizeof(r)) == static_cast<ssize_t>(sizeof(r)) &&
+             r.sequence == count + 1 && r.checksum == checksum(r))
+      {
+         apply(static_cast<int>(r.account), n412::transaction_t{ r.cents / 100.0 });
+         ++count;
+      }
+      ::close(fd);
+      return count;
+   }
+
+   void commit_throughput(std::filesystem::path const& path, std::size_t const group,
+                          int const threads, int const per_thread)
+   {
+      std::filesystem::remove(path);
+      journal j(path, static_cast<std::size_t>(threads) * per_thread,
+                group_commit{ group, std::chrono::microseconds(500) });
+
+      auto start = std::chrono::steady_clock::now();
+      std::vector<std::thread> writers;
+      for (int t = 0; t < threads; ++t)
+         writers.emplace_back([&j, t, per_thread] {
+            for (int i = 0; i < per_thread; ++i)
+               if (auto sequence = j.append(1000 + t, n412::transaction_t{ -1.25 }))
+                  j.wait_durable(*sequence);
+         });
+      for (auto& w : writers)
+         w.join();
+      auto end = std::chrono::steady_clock::now();
+
+      double seconds = std::chrono::duration<double>(end - start).count();
+      std::cout << "group of " << group << ": "
+                << threads * per_thread / seconds << " commits/s, "
+                << j.syncs() << " syncs\n";
+   }
+}
+#endif
+
+namespace n451
+{
+   using n449::cents;
+   using n449::to_cents;
+   using n449::to_amount;
+
+   template <std::size_t TopN, std::size_t Buckets>
+   struct balance_report
+   {
+      cents                                          exposure = 0;  // sum of all balances
+      std::size_t                                    top_count = 0;
+      std::array<std::pair<int, cents>, TopN>        top{};         // largest first
+      std::array<std::size_t, Buckets>               histogram{};
+   };
+
+   // holds the latest value of T for any number of readers and one writer;
+   // a read is one fetch_add to enter and one to leave, with no retry loop,
+   // so readers are wait-free; the writer waits for readers of the slot it
+   // is about to overwrite
+   template <typename T>
+   class snapshot_cell
+   {
+      static constexpr std::uint64_t index_bit = std::uint64_t{ 1 } << 63;
+
+      struct slot
+      {
+         T                          value{};
+         std::atomic<std::uint64_t> exits{ 0 };
+      };
+
+   public:
+      template <typename F>
+      auto read(F&& f) const
+      {
+         std::uint64_t const state = entries.fetch_add(1, std::memory_order_acquire);
+         slot& s = slots[(state & index_bit) ? 1 : 0];
+         auto result = f(s.value);
+         s.exits.fetch_add(1, std::memory_order_release);
+         return result;
+      }
+
+      T load() const { return read([](T const& value) { return value; }); }
+
+      void store(T const& value)
+      {
+         std::size_t const other = current ^ 1;
+         while (slots[other].exits.load(std::memory_order_acquire) != retired_entries)
+            std::this_thread::yield();
+
+         slots[other].exits.store(0, std::memory_order_relaxed);
+         slots[other].value = value;
+
+         std::uint64_t const old = entries.exchange(other ? index_bit : 0,
+                                                    std::memory_order_acq_rel);
+         retired_entries = old & ~index_bit;
+         current = other;
+      }
+
+   private:
+      std::array<slot, 2>                mutable slots;
+      std::atomic<std::uint64_t>         mutable entries{ 0 };
+      std::size_t                        current = 0;
+      std::uint64_t                      retired_entries = 0;
+   };
+
+   // balances of accounts 0..n-1 with the report kept up to date on every
+   // change: exposure and histogram in O(1), the ranking in O(log n)
+   template <std::size_t TopN = 10, std::size_t Buckets = 16>
+   class balance_book
+   {
+   public:
+      using report_type = balance_report<TopN, Buckets>;
+
+      balance_book(std::size_t const accounts, cents const bucket_width)
+         : balances(accounts, 0), bucket_width(bucket_width)
+      {
+         report.histogram[0] = accounts;
+         for (std::size_t i = 0; i < accounts; ++i)
+            ranking.emplace_hint(ranking.end(), 0, static_cast<int>(i));
+         publish();
+      }
+
+      // as with n449::atomic_balance, only positive amounts are accepted;
+      // unknown accounts are rejected rather than indexed
+      bool deposit(int const account, double const amount)
+      {
+         cents const value = to_cents(amount);
+         if (value <= 0 || !contains(account))
+            return false;
+         std::lock_guard lock(mt);
+         update(account, value);
+         return true;
+      }
+
+      std::optional<n412::transaction_t> withdraw(int const account, double const amount)
+      {
+         cents const value = to_cents(amount);
+         if (value <= 0 || !contains(account))
+            return std::nullopt;
+         std::lock_guard lock(mt);
+         if (balances[account] < value)
+            return std::nullopt;
+         update(account, -value);
+         return n412::transaction_t{ -amount };
+      }
+
+      double balance(int const account) const
+      {
+         std::lock_guard lock(mt);
+         return to_amount(balances[account]);
+      }
+
+      report_type make_report() const { return snapshot.load(); }
+
+      std::span<cents const> data() const { return balances; }
+
+   private:
+      bool contains(int const account) const
+      {
+         return account >= 0 && static_cast<std::size_t>(account) < balances.size();
+      }
+
+      std::size_t bucket_of(cents const value) const
+      {
+         if (value <= 0)
+            return 0;
+         return std::min(static_cast<std::size_t>(value / bucket_width), Buckets - 1);
+      }
+
+      void update(int const account, cents const delta)
+      {
+         cents& value = balances[account];
+         auto node = ranking.extract({ value, account });
+         --report.histogram[bucket_of(value)];
+         value += delta;
+         ++report.histogram[bucket_of(value)];
+         report.exposure += delta;
+         node.value().first = value;
+         ranking.insert(std::move(node));
+         publish();
+      }
+
+      void publish()
+      {
+         report.top_count = 0;
+         for (auto it = ranking.rbegin();
+              it != ranking.rend() && report.top_count < TopN; ++it)
+            report.top[report.top_count++] = { it->second, it->first };
+         snapshot.store(report);
+      }
+
+      std::vector<cents>                 balances;
+      std::set<std::pair<cents, int>>    ranking;
+      cents                              bucket_width;
+      report_type                        report;
+      snapshot_cell<report_type>         snapshot;
+      std::mutex                         mutable mt;
+   };
+
+   // the report as it was built before, by looking at every account
+   template <std::size_t TopN, std::size_t Buckets>
+   balance_report<TopN, Buckets> full_scan(std::span<cents const> balances,
+                                           cents const bucket_width)
+   {
+      balance_report<TopN, Buckets> report;
+      auto smaller = [](auto const& a, auto const& b) {
+         return a.second != b.second ? a.second > b.second : a.first > b.first;
+      };
+      std::array<std::pair<int, cents>, TopN> heap{};
+      std::size_t size = 0;
+
+      for (std::size_t i = 0; i < balances.size(); ++i)
+      {
+         cents const value = balances[i];
+         report.exposure += value;
+         ++report.histogram[value <= 0 ? 0 :
+            std::min(static_cast<std::size_t>(value / bucket_width), Buckets - 1)];
+
+         std::pair<int, cents> entry{ static_cast<int>(i), value };
+         if (size < TopN)
+         {
+            heap[size++] = entry;
+            std::push_heap(heap.begin(), heap.begin() + size, smaller);
+         }
+         else if (smaller(entry, heap[0]))
+         {
+            std::pop_heap(heap.begin(), heap.end(), smaller);
+            heap[TopN - 1] = entry;
+            std::push_heap(heap.begin(), heap.end(), smaller);
+         }
+      }
+
+      std::sort_heap(heap.begin(), heap.begin() + size, smaller);
+      report.top = heap;
+      report.top_count = size;
+      return report;
+   }
+
+   template <std::size_t TopN, std::size_t Buckets>
+   bool operator==(balance_report<TopN, Buckets> const& a, balance_report<TopN, Buckets> const& b)
+   {
+      return a.exposure == b.exposure && a.top_count == b.top_count &&
+             std::equal(a.top.begin(), a.top.begin() + a.top_count, b.top.begin()) &&
+             a.histogram == b.histogram;
+   }
+
+   template <typename F>
+   double microseconds_per_call(F&& f, int const calls)
+   {
+      auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < calls; ++i)
+         f();
+      auto end = std::chrono::steady_clock::now();
+      return std::chrono::duration<double, std::micro>(end - start).count() / calls;
+   }
+}
+
+namespace n452
+{
+   // the number of decimal digits at the start of [first, last)
+   inline std::size_t digit_run(char const* const first, char const* const last)
+   {
+      char const* p = first;
+#if defined(__SSE2__) || defined(_M_X64)
+      __m128i const below = _mm_set1_epi8('0' - 1);
+      __m128i const above = _mm_set1_epi8('9' + 1);
+      for (; last - p >= 16; p += 16)
+      {
+         __m128i const chunk = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+         __m128i const digits = _mm_and_si128(_mm_cmpgt_epi8(chunk, below),
+                                              _mm_cmplt_epi8(chunk, above));
+         unsigned const others = ~static_cast<unsigned>(_mm_movemask_epi8(digits)) & 0xffff;
+         if (others != 0)
+            return static_cast<std::size_t>(p - first) + std::countr_zero(others);
+      }
+#endif
+      while (p != last && *p >= '0' && *p <= '9')
+         ++p;
+      return static_cast<std::size_t>(p - first);
+   }
+
+   // the number of rows in text, for sizing the columns before parsing
+   inline std::size_t count_rows(std::string_view const text)
+   {
+      std::size_t rows = static_cast<std::size_t>(std::count(text.begin(), text.end(), '\n'));
+      return !text.empty() && text.back() != '\n' ? rows + 1 : rows;
+   }
+
+   // parses lines of "number,amount" into the two columns, which must have
+   // room for count_rows(text) entries; blank lines are skipped, nothing is
+   // allocated, and the number of rows parsed is returned
+   inline std::size_t parse_rows(std::string_view const text,
+                                 std::span<int> numbers, std::span<double> amounts)
+   {
+      char const* p = text.data();
+      char const* const last = p + text.size();
+      std::size_t row = 0;
+      std::size_t line = 1;
+
+      auto fail = [&line](char const* what) {
+         throw std::runtime_error(std::string(what) + " on line " + std::to_string(line));
+      };
+
+      for (; p != last; ++line)
+      {
+         if (*p == '\n' || *p == '\r')
+         {
+            line -= *p == '\r';
+            ++p;
+            continue;
+         }
+         if (row >= numbers.size() || row >= amounts.size())
+            throw std::out_of_range("columns too small for the parsed rows");
+
+         // the digits are already validated, so up to nine of them cannot
+         // overflow and need no further checks
+         std::size_t const length = digit_run(p, last);
+         if (length == 0 || p + length == last || p[length] != ',')
+            fail("invalid account number");
+         int number = 0;
+         if (length <= 9)
+         {
+            for (std::size_t i = 0; i < length; ++i)
+               number = number * 10 + (p[i] - '0');
+         }
+         else if (std::from_chars(p, p + length, number).ec != std::errc{})
+            fail("account number out of range");
+         p += length + 1;
+
+         double amount;
+         auto [end, ec] = std::from_chars(p, last, amount);
+         if (ec != std::errc{})
+            fail("invalid amount");
+         p = end;
+         if (p != last && *p == '\r')
+            ++p;
+         if (p != last && *p++ != '\n')
+            fail("unexpected text after amount");
+
+         numbers[row] = number;
+         amounts[row] = amount;
+         ++row;
+      }
+      return row;
+   }
+
+   // the same rows parsed one line at a time through account_t::from_string
+   inline std::size_t parse_rows_by_string(std::string_view text,
+                                           std::vector<int>& numbers, std::vector<double>& amounts)
+   {
+      std::size_t rows = 0;
+      while (!text.empty())
+      {
+         std::size_t const end = std::min(text.find('\n'), text.size());
+         std::string const line(text.substr(0, end));
+         text.remove_prefix(std::min(end + 1, text.size()));
+         std::size_t const comma = line.find(',');
+         if (comma == std::string::npos)
+            continue;
+         numbers.push_back(n412::account_t{}.from_string(line.substr(0, comma)));
+         amounts.push_back(std::stod(line.substr(comma + 1)));
+         ++rows;
+      }
+      return rows;
+   }
+
+#if defined(__unix__) || defined(__APPLE__)
+   // a read-only view of a whole file
+   class mapped_file
+   {
+   public:
+      explicit mapped_file(std::filesystem::path const& path)
+      {
+         fd = ::open(path.c_str(), O_RDONLY);
+         if (fd < 0)
+            throw std::runtime_error("cannot open " + path.string());
+
+         struct stat st{};
+         if (::fstat(fd, &st) != 0)
+         {
+            ::close(fd);
+            throw std::runtime_error("cannot stat " + path.string());
+         }
+
+         size = static_cast<std::size_t>(st.st_size);
+         if (size > 0)
+         {
+            void* p = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED)
+            {
+               ::close(fd);
+               throw std::runtime_error("cannot map " + path.string());
+            }
+            ::madvise(p, size, MADV_SEQUENTIAL);
+            data = static_cast<char const*>(p);
+         }
+      }
+
+      mapped_file(mapped_file const&) = delete;
+      mapped_file& operator=(mapped_file const&) = delete;
+
+      ~mapped_file()
+      {
+         if (data)
+            ::munmap(const_cast<char*>(data), size);
+         ::close(fd);
+      }
+
+      std::string_view text() const noexcept { return { data, size }; }
+
+   private:
+      int         fd = -1;
+      char const* data = nullptr;
+      std::size_t size = 0;
+   };
+#endif
+}
+
+namespace n453
+{
+   template <auto Member>
+   struct member_traits;
+
+   template <typename C, typename T, T C::* Member>
+   struct member_traits<Member>
+   {
+      using class_type = C;
+      using value_type = T;
+   };
+
+   // applies a chain of data member pointers, so that project<&balance_t::account,
+   // &account_t::number>(b) is b.account.number
+   template <auto Member, auto... Members>
+   constexpr decltype(auto) project(typename member_traits<Member>::class_type const& object)
+   {
+      if constexpr (sizeof...(Members) == 0)
+         return (object.*Member);
+      else
+         return project<Members...>(object.*Member);
+   }
+
+   template <auto Member, auto... Members>
+   struct projection
+   {
+      using type = std::remove_cvref_t<decltype(project<Member, Members...>(
+         std::declval<typename member_traits<Member>::class_type const&>()))>;
+   };
+
+   template <auto... Members>
+   using projected_t = typename projection<Members...>::type;
+
+   template <typename K>
+   concept radix_key = (std::is_integral_v<K> && !std::is_same_v<K, bool>) ||
+                       (std::is_floating_point_v<K> && (sizeof(K) == 4 || sizeof(K) == 8));
+
+   // maps a key to an unsigned integer with the same order; -0.0 maps to
+   // the same value as +0.0 since the two compare equal, and NaN, which has
+   // no place in the order, maps past the infinities with its sign
+   template <radix_key K>
+   constexpr auto to_unsigned(K const key)
+   {
+      if constexpr (std::is_integral_v<K>)
+      {
+         using U = std::make_unsigned_t<K>;
+         U value = static_cast<U>(key);
+         if constexpr (std::is_signed_v<K>)
+            value ^= U{ 1 } << (sizeof(K) * 8 - 1);
+         return value;
+      }
+      else
+      {
+         using U = std::conditional_t<sizeof(K) == 4, std::uint32_t, std::uint64_t>;
+         U const value = std::bit_cast<U>(key == K{} ? K{} : key);
+         U const sign = U{ 1 } << (sizeof(K) * 8 - 1);
+         return (value & sign) ? static_cast<U>(~value) : static_cast<U>(value | sign);
+      }
+   }
+
+   static_assert(to_unsigned(-1) < to_unsigned(0) && to_unsigned(0) < to_unsigned(1));
+   static_assert(to_unsigned(-2.5) < to_unsigned(-1.0) && to_unsigned(-1.0) < to_unsigned(0.5));
+   static_assert(to_unsigned(-0.0) == to_unsigned(0.0) && to_unsigned(-0.0f) == to_unsigned(0.0f));
+
+   // the stable order of the keys, by least significant digit radix sort
+   // with 11-bit digits; the counts for every digit come from one pass, and
+   // passes where every key has the same digit are skipped
+   template <typename U>
+   std::vector<std::uint32_t> radix_order(std::vector<U> const& keys)
+   {
+      constexpr unsigned digit_bits = 11;
+      constexpr std::size_t buckets = std::size_t{ 1 } << digit_bits;
+      constexpr unsigned digits = (sizeof(U) * 8 + digit_bits - 1) / digit_bits;
+
+      struct entry
+      {
+         U             key;
+         std::uint32_t position;
+      };
+
+      std::size_t const n = keys.size();
+      std::vector<entry> current(n);
+      std::vector<entry> next(n);
+      std::vector<std::array<std::uint32_t, buckets>> counts(digits);
+      for (std::size_t i = 0; i < n; ++i)
+      {
+         current[i] = { keys[i], static_cast<std::uint32_t>(i) };
+         for (unsigned d = 0; d < digits; ++d)
+            ++counts[d][(keys[i] >> (d * digit_bits)) & (buckets - 1)];
+      }
+
+      for (unsigned d = 0; d < digits; ++d)
+      {
+         auto& count = counts[d];
+         if (std::find(count.begin(), count.end(), n) != count.end())
+            continue;
+
+         std::uint32_t offset = 0;
+         for (auto& c : count)
+            offset += std::exchange(c, offset);
+         for (entry const& e : current)
+            next[count[(e.key >> (d * digit_bits)) & (buckets - 1)]++] = e;
+         current.swap(next);
+      }
+
+      std::vector<std::uint32_t> order(n);
+      for (std::size_t i = 0; i < n; ++i)
+         order[i] = current[i].position;
+      return order;
+   }
+
+   // sorts the range by the projected member, keeping the order of equal keys;
+   // arithmetic keys are copied into a column and radix sorted; floating point
+   // keys must not be NaN, as for std::ranges::less
+   template <auto... Members, std::ranges::random_access_range R>
+   void sort_by(R&& range)
+   {
+      using value_type = std::ranges::range_value_t<R>;
+      using key_type = projected_t<Members...>;
+      auto key = [](value_type const& v) -> decltype(auto) { return project<Members...>(v); };
+
+      if constexpr (radix_key<key_type>)
+      {
+         if (std::ranges::size(range) > std::numeric_limits<std::uint32_t>::max())
+         {
+            std::ranges::stable_sort(range, std::ranges::less{}, key);
+            return;
+         }
+
+         using U = decltype(to_unsigned(key_type{}));
+         std::vector<U> keys;
+         keys.reserve(std::ranges::size(range));
+         for (auto const& v : range)
+            keys.push_back(to_unsigned(key(v)));
+
+         std::vector<value_type> sorted;
+         sorted.reserve(keys.size());
+         auto first = std::ranges::begin(range);
+         for (std::uint32_t const i : radix_order(keys))
+            sorted.push_back(std::move(first[i]));
+         std::ranges::move(sorted, first);
+      }
+      else
+      {
+         std::ranges::stable_sort(range, std::ranges::less{}, key);
+      }
+   }
+
+   // sorts the range by the projected member and returns the runs of
+   // elements with equal keys
+   template <auto... Members, std::ranges::random_access_range R>
+   auto group_by(R&& range)
+   {
+      sort_by<Members...>(range);
+
+      using iterator = std::ranges::iterator_t<R>;
+      std::vector<std::ranges::subrange<iterator>> groups;
+      auto first = std::ranges::begin(range);
+      auto const last = std::ranges::end(range);
+      while (first != last)
+      {
+         auto const& key = project<Members...>(*first);
+         auto next = std::find_if(first, last, [&key](auto const& v) {
+            return !(project<Members...>(v) == key); });
+         groups.emplace_back(first, next);
+         first = next;
+      }
+      return groups;
+   }
+
+   // maps the projected member to the position of the first element with it
+   template <auto... Members, std::ranges::forward_range R>
+   auto index_by(R const& range)
+   {
+      std::unordered_map<projected_t<Members...>, std::size_t> index;
+      index.reserve(std::ranges::size(range));
+      std::size_t position = 0;
+      for (auto const& v : range)
+         index.try_emplace(project<Members...>(v), position++);
+      return index;
+   }
+}
+
+namespace n454
+{
+   // hands out memory from large chunks by bumping a pointer; deallocation
+   // does nothing, and everything is given back at once by reset or release
+   class arena : public std::pmr::memory_resource
+   {
+   public:
+      explicit arena(std::size_t const initial_size = 4096,
+                     std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+         : next_size(initial_size), upstream(upstream)
+      {}
+
+      arena(arena const&) = delete;
+      arena& operator=(arena const&) = delete;
+      ~arena() { release(); }
+
+      // returns every chunk to the upstream resource
+      void release() noexcept
+      {
+         while (chunks)
+         {
+            chunk* next = chunks->next;
+            upstream->deallocate(chunks, chunks->size, alignof(std::max_align_t));
+            chunks = next;
+         }
+         current = end = nullptr;
+      }
+
+      // forgets all allocations but keeps the newest, largest chunk for reuse
+      void reset() noexcept
+      {
+         if (!chunks)
+            return;
+         chunk* keep = chunks;
+         chunks = chunks->next;
+         release();
+         keep->next = nullptr;
+         chunks = keep;
+         current = reinterpret_cast<std::byte*>(keep + 1);
+         end = reinterpret_cast<std::byte*>(keep) + keep->size;
+      }
+
+   private:
+      struct alignas(std::max_align_t) chunk
+      {
+         chunk*      next;
+         std::size_t size;
+      };
+
+      void* do_allocate(std::size_t const bytes, std::size_t const alignment) override
+      {
+         void* p = current;
+         std::size_t space = static_cast<std::size_t>(end - current);
+         if (!current || !std::align(alignment, bytes, p, space))
+         {
+            std::size_t const needed = sizeof(chunk) + bytes + alignment;
+            while (next_size < needed)
+               next_size *= 2;
+            auto* c = static_cast<chunk*>(upstream->allocate(next_size, alignof(std::max_align_t)));
+            c->next = chunks;
+            c->size = next_size;
+            chunks = c;
+            current = reinterpret_cast<std::byte*>(c + 1);
+            end = reinterpret_cast<std::byte*>(c) + next_size;
+            next_size *= 2;
+
+            p = current;
+            space = static_cast<std::size_t>(end - current);
+            std::align(alignment, bytes, p, space);
+         }
+         current = static_cast<std::byte*>(p) + bytes;
+         return p;
+      }
+
+      void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+      bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override
+      {
+         return this == &other;
+      }
+
+      chunk*                     chunks = nullptr;
+      std::byte*                 current = nullptr;
+      std::byte*                 end = nullptr;
+      std::size_t                next_size;
+      std::pmr::memory_resource* upstream;
+   };
+
+   // keeps freed blocks in one list per power-of-two size, up to 512 bytes,
+   // and reuses them; larger or over-aligned blocks go to the upstream resource
+   class pool : public std::pmr::memory_resource
+   {
+      static constexpr std::size_t min_shift = 3;
+      static constexpr std::size_t max_shift = 9;
+      static constexpr std::size_t chunk_size = 16 * 1024;
+
+   public:
+      explicit pool(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+         : chunks(upstream)
+      {}
+
+      pool(pool const&) = delete;
+      pool& operator=(pool const&) = delete;
+
+   private:
+      struct block { block* next; };
+
+      static std::size_t size_class(std::size_t const bytes)
+      {
+         std::size_t const shift = std::bit_width(std::max(bytes, std::size_t{ 1 } << min_shift) - 1);
+         return shift - min_shift;
+      }
+
+      void* do_allocate(std::size_t const bytes, std::size_t const alignment) override
+      {
+         if (bytes > (std::size_t{ 1 } << max_shift) || alignment > alignof(std::max_align_t))
+            return chunks.upstream_resource()->allocate(bytes, alignment);
+
+         std::size_t const c = size_class(bytes);
+         if (!free[c])
+         {
+            // the chunks are only given back when the pool is destroyed
+            std::size_t const size = std::size_t{ 1 } << (c + min_shift);
+            auto* p = static_cast<std::byte*>(chunks.allocate(chunk_size, alignof(std::max_align_t)));
+            for (std::size_t offset = 0; offset + size <= chunk_size; offset += size)
+               free[c] = ::new (p + offset) block{ free[c] };
+         }
+         block* b = free[c];
+         free[c] = b->next;
+         return b;
+      }
+
+      void do_deallocate(void* p, std::size_t const bytes, std::size_t const alignment) override
+      {
+         if (bytes > (std::size_t{ 1 } << max_shift) || alignment > alignof(std::max_align_t))
+            return chunks.upstream_resource()->deallocate(p, bytes, alignment);
+
+         std::size_t const c = size_class(bytes);
+         free[c] = ::new (p) block{ free[c] };
+      }
+
+      bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override
+      {
+         return this == &other;
+      }
+
+      std::array<block*, max_shift - min_shift + 1> free{};
+      std::pmr::monotonic_buffer_resource         chunks;
+   };
+
+   // the resource default-constructed resource_allocators use on this thread
+   inline std::pmr::memory_resource*& current_resource() noexcept
+   {
+      thread_local std::pmr::memory_resource* resource = std::pmr::new_delete_resource();
+      return resource;
+   }
+
+   // makes a resource current for the lifetime of the scope
+   class use_resource
+   {
+   public:
+      explicit use_resource(std::pmr::memory_resource& resource) noexcept
+         : previous(std::exchange(current_resource(), &resource))
+      {}
+      use_resource(use_resource const&) = delete;
+      use_resource& operator=(use_resource const&) = delete;
+      ~use_resource() { current_resource() = previous; }
+
+   private:
+      std::pmr::memory_resource* previous;
+   };
+
+   // an allocator over a memory resource, like std::pmr::polymorphic_allocator,
+   // but default-constructible from the thread's current resource, so it can
+   // be named only by type, as the Allocator parameter of a template
+   template <typename T>
+   class resource_allocator
+   {
+   public:
+      using value_type = T;
+
+      resource_allocator() noexcept : resource(current_resource()) {}
+      resource_allocator(std::pmr::memory_resource* resource) noexcept : resource(resource) {}
+
+      template <typename U>
+      resource_allocator(resource_allocator<U> const& other) noexcept
+         : resource(other.get_resource())
+      {}
+
+      T* allocate(std::size_t const n)
+      {
+         return static_cast<T*>(resource->allocate(n * sizeof(T), alignof(T)));
+      }
+
+      void deallocate(T* p, std::size_t const n) noexcept
+      {
+         resource->deallocate(p, n * sizeof(T), alignof(T));
+      }
+
+      std::pmr::memory_resource* get_resource() const noexcept { return resource; }
+
+      template <typename U>
+      bool operator==(resource_allocator<U> const& other) const noexcept
+      {
+         return *resource == *other.get_resource();
+      }
+
+   private:
+      std::pmr::memory_resource* resource;
+   };
+
+   // counts the allocations that reach it
+   class counting_resource : public std::pmr::memory_resource
+   {
+   public:
+      std::size_t allocations = 0;
+
+   private:
+      void* do_allocate(std::size_t const bytes, std::size_t const alignment) override
+      {
+         ++allocations;
+         return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+      }
+
+      void do_deallocate(void* p, std::size_t const bytes, std::size_t const alignment) override
+      {
+         std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+      }
+
+      bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override
+      {
+         return this == &other;
+      }
+   };
+
+   // a request that builds and discards many small vectors
+   template <template <typename> class Allocator>
+   std::size_t handle_request(int const id)
+   {
+      std::size_t total = 0;
+      for (int i = 0; i < 64; ++i)
+      {
+         auto v = n418::make_vector<Allocator>(id, i, id + i, id * i, 1, 2, 3, 4);
+         n420::range_t r(v.begin(), v.end(), Allocator<int>());
+         total += std::accumulate(r.begin(), r.end(), std::size_t{ 0 });
+      }
+      return total;
+   }
+
+   template <typename Reset>
+   void measure(char const* name, counting_resource const& counter, int const requests,
+                Reset reset)
    {
-      // std::cout << w.value << '\n'; // error
+      std::size_t const before = counter.allocations;
+      std::size_t total = 0;
+      auto start = std::chrono::steady_clock::now();
+      for (int id = 0; id < requests; ++id)
+      {
+         total += handle_request<resource_allocator>(id);
+         reset();
+      }
+      auto end = std::chrono::steady_clock::now();
+
+      std::cout << name << ": "
+                << static_cast<double>(counter.allocations - before) / requests
+                << " allocations/request, "
+                << std::chrono::duration<double, std::micro>(end - start).count() / requests
+                << "us/request (" << total % 10 << ")\n";
    }
+}
 
-   template<>
-   void print(wrapper<int> const& w)
+#if defined(__unix__) || defined(__APPLE__)
+namespace n455
+{
+   struct endpoint
    {
-      std::cout << w.value << '\n';
-   }
+      std::string host;
+      int         port;
 
-   template <typename T>
-   struct printer
+      bool operator==(endpoint const&) const = default;
+   };
+
+   struct endpoint_hash
    {
-      void operator()(wrapper<T> const& w)
+      std::size_t operator()(endpoint const& e) const noexcept
       {
-         //std::cout << w.value << '\n'; // error
+         return std::hash<std::string>{}(e.host) ^ (std::hash<int>{}(e.port) << 1);
       }
    };
 
-   template <>
-   struct printer<int>
+   // a connected TCP socket, or -1
+   inline int connect_to(endpoint const& e)
    {
-      void operator()(wrapper<int> const& w)
+      addrinfo hints{};
+      hints.ai_family = AF_UNSPEC;
+      hints.ai_socktype = SOCK_STREAM;
+      addrinfo* addresses = nullptr;
+      if (::getaddrinfo(e.host.c_str(), std::to_string(e.port).c_str(), &hints, &addresses) != 0)
+         return -1;
+
+      int fd = -1;
+      for (addrinfo* a = addresses; a && fd < 0; a = a->ai_next)
       {
-         std::cout << w.value << '\n';
+         fd = ::socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+         if (fd >= 0 && ::connect(fd, a->ai_addr, a->ai_addrlen) != 0)
+         {
+            ::close(fd);
+            fd = -1;
+         }
       }
-   };
-}
+      ::freeaddrinfo(addresses);
+
+      if (fd >= 0)
+      {
+         int const on = 1;
+         ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+      }
+      return fd;
+   }
 
-namespace n443
-{
    template <typename T>
-   struct printer;
+   class connection_pool;
 
+   // a socket to an endpoint; as with n445::connection, only T can use it,
+   // and only T or the pool can open one
    template <typename T>
-   struct wrapper
+   class connection
    {
-      wrapper(T const v) :value(v) {}
+   public:
+      connection(connection const&) = delete;
+      connection& operator=(connection const&) = delete;
+      ~connection() { ::close(fd); }
+
    private:
-      T value;
+      explicit connection(endpoint const& e)
+         : info(e.host, e.port), fd(connect_to(e))
+      {
+         if (fd < 0)
+            throw std::runtime_error("cannot connect to " + e.host + ':' + std::to_string(e.port));
+      }
 
-      template <typename U>
-      friend void print(wrapper<U> const&);
+      n445::connection<T>                   info;
+      int                                   fd;
+      std::chrono::steady_clock::time_point last_used;
+      bool                                  broken = false;   // set by T when I/O fails
 
-      template <typename U>
-      friend struct printer;
+      friend T;
+      friend class connection_pool<T>;
    };
 
+   // keeps up to a fixed number of open connections per endpoint; idle
+   // connections sit in a slot array and are taken and returned with atomic
+   // exchanges, and the set of endpoints is fixed at construction
    template <typename T>
-   void print(wrapper<T> const& w)
+   class connection_pool
    {
-      std::cout << w.value << '\n';
-   }
+      struct endpoint_slots
+      {
+         endpoint                                            where;
+         std::size_t                                         limit;
+         std::unique_ptr<std::atomic<connection<T>*>[]>      idle;
+         std::atomic<std::size_t>                            open{ 0 };
+      };
 
-   template <typename T>
-   struct printer
-   {
-      void operator()(wrapper<T> const& w)
+   public:
+      // returns the connection to the pool when destroyed
+      class lease
       {
-         std::cout << w.value << '\n';
+      public:
+         lease() = default;
+         lease(lease&& other) noexcept
+            : slots(std::exchange(other.slots, nullptr)), c(std::exchange(other.c, nullptr))
+         {}
+         lease& operator=(lease&& other) noexcept
+         {
+            if (this != &other)
+            {
+               release();
+               slots = std::exchange(other.slots, nullptr);
+               c = std::exchange(other.c, nullptr);
+            }
+            return *this;
+         }
+         ~lease() { release(); }
+
+         explicit operator bool() const noexcept { return c != nullptr; }
+         connection<T>& operator*() const noexcept { return *c; }
+         connection<T>* operator->() const noexcept { return c; }
+
+         // closes the connection instead of returning it to the pool, for
+         // one that can no longer be used
+         void discard() noexcept
+         {
+            if (c)
+            {
+               delete c;
+               slots->open.fetch_sub(1, std::memory_order_relaxed);
+               c = nullptr;
+            }
+         }
+
+      private:
+         lease(endpoint_slots* slots, connection<T>* c) : slots(slots), c(c) {}
+
+         void release() noexcept
+         {
+            if (c && c->broken)
+               discard();
+            else if (c)
+            {
+               c->last_used = std::chrono::steady_clock::now();
+               put(*slots, c);
+               c = nullptr;
+            }
+         }
+
+         endpoint_slots* slots = nullptr;
+         connection<T>*  c = nullptr;
+
+         friend connection_pool;
+      };
+
+      connection_pool(std::vector<endpoint> const& endpoints, std::size_t const per_endpoint)
+      {
+         for (auto const& e : endpoints)
+         {
+            auto slots = std::make_unique<endpoint_slots>();
+            slots->where = e;
+            slots->limit = per_endpoint;
+            slots->idle = std::make_unique<std::atomic<connection<T>*>[]>(per_endpoint);
+            this->endpoints.emplace(e, std::move(slots));
+         }
       }
-   };
-}
 
-namespace n444
-{
-   template <typename T>
-   struct printer;
+      connection_pool(connection_pool const&) = delete;
+      connection_pool& operator=(connection_pool const&) = delete;
 
-   template <typename T>
-   struct wrapper
-   {
-      wrapper(T const v) :value(v) {}
-   private:
-      T value;
+      // all leases must have been returned
+      ~connection_pool()
+      {
+         for (auto& [e, slots] : endpoints)
+            for (std::size_t i = 0; i < slots->limit; ++i)
+               delete slots->idle[i].exchange(nullptr);
+      }
 
-      friend void print<T>(wrapper<T> const&);
-      friend struct printer<T>;
-   };
+      // an idle connection, a new one if the endpoint is below its limit,
+      // or an empty lease
+      lease try_checkout(endpoint const& e)
+      {
+         endpoint_slots& slots = find(e);
+         for (std::size_t i = 0; i < slots.limit; ++i)
+         {
+            if (slots.idle[i].load(std::memory_order_relaxed))
+               if (connection<T>* c = slots.idle[i].exchange(nullptr, std::memory_order_acquire))
+                  return lease(&slots, c);
+         }
+
+         std::size_t open = slots.open.load(std::memory_order_relaxed);
+         while (open < slots.limit)
+         {
+            if (slots.open.compare_exchange_weak(open, open + 1, std::memory_order_relaxed))
+            {
+               try
+               {
+                  return lease(&slots, new connection<T>(e));
+               }
+               catch (...)
+               {
+                  slots.open.fetch_sub(1, std::memory_order_relaxed);
+                  throw;
+               }
+            }
+         }
+         return {};
+      }
 
-   template <typename T>
-   void print(wrapper<T> const& w)
-   {
-      std::cout << w.value << '\n';
-   }
+      // waits until a connection is available or the timeout expires
+      lease checkout(endpoint const& e,
+                     std::chrono::steady_clock::duration const timeout = std::chrono::seconds(1))
+      {
+         auto const deadline = std::chrono::steady_clock::now() + timeout;
+         for (;;)
+         {
+            if (lease l = try_checkout(e))
+               return l;
+            if (std::chrono::steady_clock::now() >= deadline)
+               throw std::runtime_error("no connection available to " + e.host);
+            std::this_thread::yield();
+         }
+      }
 
-   template <typename T>
-   struct printer
-   {
-      void operator()(wrapper<T> const& w)
+      // closes the connections that have been idle for longer than max_idle,
+      // and returns how many there were
+      std::size_t evict_idle(std::chrono::steady_clock::duration const max_idle)
       {
-         std::cout << w.value << '\n';
+         auto const now = std::chrono::steady_clock::now();
+         std::size_t evicted = 0;
+         for (auto& [e, slots] : endpoints)
+         {
+            for (std::size_t i = 0; i < slots->limit; ++i)
+            {
+               connection<T>* c = slots->idle[i].exchange(nullptr, std::memory_order_acquire);
+               if (!c)
+                  continue;
+               if (now - c->last_used > max_idle)
+               {
+                  delete c;
+                  slots->open.fetch_sub(1, std::memory_order_relaxed);
+                  ++evicted;
+               }
+               else
+                  put(*slots, c);
+            }
+         }
+         return evicted;
+      }
+
+      std::size_t open_connections(endpoint const& e) const
+      {
+         return find(e).open.load(std::memory_order_relaxed);
       }
-   };
-}
 
-namespace n445
-{
-   template <typename T>
-   struct connection
-   {
-      connection(std::string const& host, int const port) 
-         :ConnectionString(host + ":" + std::to_string(port)) 
-      {}
    private:
-      std::string ConnectionString;
-      friend T;
-   };
+      endpoint_slots& find(endpoint const& e) const
+      {
+         auto it = endpoints.find(e);
+         if (it == endpoints.end())
+            throw std::out_of_range("unknown endpoint " + e.host + ':' + std::to_string(e.port));
+         return *it->second;
+      }
 
-   struct executor
-   {
-      void run()
+      // there are as many slots as connections can be open, so one is free
+      static void put(endpoint_slots& slots, connection<T>* c) noexcept
       {
-         connection<executor> c("localhost", 1234);
-         
-         std::cout << c.ConnectionString << '\n';
+         for (;;)
+         {
+            for (std::size_t i = 0; i < slots.limit; ++i)
+            {
+               connection<T>* expected = nullptr;
+               if (slots.idle[i].compare_exchange_strong(expected, c, std::memory_order_release,
+                                                         std::memory_order_relaxed))
+                  return;
+            }
+         }
       }
+
+      std::unordered_map<endpoint, std::unique_ptr<endpoint_slots>, endpoint_hash> endpoints;
    };
-}
 
-namespace n446
-{
-   struct dictionary_traits
+   // sends a message and reads back as many bytes
+   struct echo_client
    {
-      using key_type = int;
-      using map_type = std::map<key_type, std::string>;
-      static constexpr int identity = 1;
+      static std::string call(connection<echo_client>& c, std::string_view const message)
+      {
+         for (std::size_t sent = 0; sent < message.size();)
+         {
+            ssize_t const n = ::send(c.fd, message.data() + sent, message.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0)
+            {
+               c.broken = true;
+               throw std::runtime_error("send to " + c.info.ConnectionString + " failed");
+            }
+            sent += static_cast<std::size_t>(n);
+         }
+
+         std::string reply(message.size(), '\0');
+         for (std::size_t received = 0; received < reply.size();)
+         {
+            ssize_t const n = ::recv(c.fd, reply.data() + received, reply.size() - received, 0);
+            if (n <= 0)
+            {
+               c.broken = true;
+               throw std::runtime_error("receive from " + c.info.ConnectionString + " failed");
+            }
+            received += static_cast<std::size_t>(n);
+         }
+         return reply;
+      }
+
+      // the unpooled way: a new connection for every call
+      static std::string call(endpoint const& e, std::string_view const message)
+      {
+         connection<echo_client> c(e);
+         return call(c, message);
+      }
    };
 
-   template <typename T>
-   struct dictionary : T::map_type
+   // echoes everything back, one thread per accepted connection
+   class echo_server
    {
-      int start_key{ T::identity };
-      T::key_type next_key;
+   public:
+      echo_server()
+      {
+         listener = ::socket(AF_INET, SOCK_STREAM, 0);
+         int const on = 1;
+         ::setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+         sockaddr_in address{};
+         address.sin_family = AF_INET;
+         address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+         address.sin_port = 0;
+         socklen_t length = sizeof(address);
+         if (::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+             ::listen(listener, 128) != 0 ||
+             ::getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length) != 0)
+         {
+            ::close(listener);
+            throw std::runtime_error("cannot listen on loopback");
+         }
+         port = ntohs(address.sin_port);
+         acceptor = std::thread([this] { accept_loop(); });
+      }
 
-      using value_type = T::map_type::mapped_type;
+      echo_server(echo_server const&) = delete;
+      echo_server& operator=(echo_server const&) = delete;
+
+      // clients must have closed their connections by now
+      ~echo_server()
+      {
+         ::shutdown(listener, SHUT_RDWR);
+         acceptor.join();
+         ::close(listener);
+         for (auto& s : sessions)
+            s.thread.join();
+      }
+
+      endpoint where() const { return { "127.0.0.1", port }; }
+
+   private:
+      struct session
+      {
+         std::unique_ptr<std::atomic<bool>> done;
+         std::thread                        thread;
+      };
+
+      // joins the sessions whose clients have disconnected, so that only
+      // the live ones are kept until the server is destroyed
+      void reap_sessions()
+      {
+         std::erase_if(sessions, [](session& s) {
+            if (!s.done->load(std::memory_order_acquire))
+               return false;
+            s.thread.join();
+            return true;
+         });
+      }
+
+      void accept_loop()
+      {
+         for (;;)
+         {
+            int const fd = ::accept(listener, nullptr, nullptr);
+            if (fd < 0)
+               return;
+            reap_sessions();
+            sessions.reserve(sessions.size() + 1);
+            auto done = std::make_unique<std::atomic<bool>>(false);
+            std::thread thread([fd, &done = *done] {
+               int const on = 1;
+               ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+               char buffer[4096];
+               ssize_t n;
+               while ((n = ::recv(fd, buffer, sizeof(buffer), 0)) > 0)
+                  if (::send(fd, buffer, static_cast<std::size_t>(n), MSG_NOSIGNAL) != n)
+                     break;
+               ::close(fd);
+               done.store(true, std::memory_order_release);
+            });
+            sessions.push_back({ std::move(done), std::move(thread) });
+         }
+      }
 
-      void add(T::key_type const&, value_type const&) {}
+      int                  listener = -1;
+      int                  port = 0;
+      std::thread          acceptor;
+      std::vector<session> sessions;
    };
+
+   template <typename F>
+   void measure_latency(char const* name, int const requests, F&& request)
+   {
+      std::vector<double> latencies(requests);
+      for (auto& l : latencies)
+      {
+         auto start = std::chrono::steady_clock::now();
+         request();
+         auto end = std::chrono::steady_clock::now();
+         l = std::chrono::duration<double, std::micro>(end - start).count();
+      }
+      std::sort(latencies.begin(), latencies.end());
+      std::cout << name << ": mean "
+                << std::accumulate(latencies.begin(), latencies.end(), 0.0) / requests
+                << "us, p99 " << latencies[requests * 99 / 100] << "us\n";
+   }
 }
+#endif
 
 namespace std
 {
@@ -1130,8 +3435,12 @@ namespace std
    pair(char const*, char const*) -> pair<std::string, std::string>;
 }
 
-int main()
+int main(int argc, char* argv[])
 {
+   // the timing runs use full-size inputs only with --bench; by default
+   // they use small ones so that the samples finish in a moment
+   bool const bench = argc > 1 && std::string_view(argv[1]) == "--bench";
+
    {
       using namespace n401;
 
@@ -1409,6 +3718,48 @@ int main()
       range_t r(std::begin(arr), std::end(arr));
    }
 
+   {
+      using namespace n420;
+
+      std::vector<int> v{ 1,2,3 };
+      range_t owned(v.begin(), v.end());      // range_t<int>, copied
+      range_t copied(v);                      // range_t<int>, copied
+      range_t borrowed(borrow, v);            // range_t<int, ownership::borrowed>
+      range_t moved(std::vector<int>{ 4,5 }); // range_t<int>, moved
+      static_assert(std::is_same_v<decltype(borrowed), range_t<int, ownership::borrowed>>);
+      static_assert(std::is_same_v<decltype(copied), range_t<int>>);
+      static_assert(std::is_same_v<decltype(moved), range_t<int>>);
+      range_t copy(owned);
+      static_assert(std::is_same_v<decltype(copy), range_t<int>>);
+      std::cout << owned.size() << copied.size() << borrowed.size() << moved.size() << '\n';
+
+      int const count = bench ? 10'000'000 : 100'000;
+      std::vector<int> source(count);
+      std::iota(source.begin(), source.end(), 0);
+      std::deque<int> chunks(source.begin(), source.end());
+
+      auto measure = [](char const* name, auto make) {
+         auto start = std::chrono::steady_clock::now();
+         auto r = make();
+         auto end = std::chrono::steady_clock::now();
+         std::cout << name << ": "
+                   << std::chrono::duration<double, std::milli>(end - start).count()
+                   << "ms, " << r.size() << " elements\n";
+      };
+
+      measure("back_inserter", [&] {
+         std::vector<int> data;
+         std::copy(chunks.begin(), chunks.end(), std::back_inserter(data));
+         return data;
+      });
+      measure("reserved", [&] { return range_t(chunks.begin(), chunks.end()); });
+      measure("contiguous", [&] { return range_t(source.begin(), source.end()); });
+      std::vector<int> spare(source);
+      measure("moved", [&] { return range_t(std::move(spare)); });
+      measure("copied", [&] { return range_t(source); });
+      measure("borrowed", [&] { return range_t(borrow, source); });
+   }
+
    {
       std::pair<int, std::string> p1{ 1, "one" };  // [1] OK
       std::pair p2{ 2, "two" };                    // [2] OK
@@ -1791,4 +4142,414 @@ int main()
       dictionary<dictionary_traits> d;
       d.add(1, "2");
    }
-}
+
+   {
+      using namespace n446;
+
+      dictionary<dense_dictionary_traits> d;
+      auto first = d.add("one");
+      auto second = d.add("two");
+      d.add(first, "uno");
+      std::cout << first << ':' << *d.get(first) << ' ' << second << ':' << *d.get(second)
+                << ' ' << (d.get(42) == nullptr) << '\n';
+
+      int const count = bench ? 2'000'000 : 20'000;
+      std::vector<int> sequential(count);
+      std::iota(sequential.begin(), sequential.end(), dense_dictionary_traits::identity);
+      std::vector<int> random = sequential;
+      std::shuffle(random.begin(), random.end(), std::mt19937(42));
+      std::vector<int> few_random(random.begin(), random.begin() + count / 20);
+
+      measure<dense_dictionary_traits>("dense sequential", sequential);
+      measure<dense_dictionary_traits>("dense random", random);
+      measure<flat_dictionary_traits>("flat_map sequential", sequential);
+      measure<flat_dictionary_traits>("flat_map random (1/20 of the keys)", few_random);
+      measure<hash_dictionary_traits>("open_hash_map sequential", sequential);
+      measure<hash_dictionary_traits>("open_hash_map random", random);
+      measure<dictionary_traits>("std::map sequential", sequential);
+      measure<dictionary_traits>("std::map random", random);
+   }
+
+   {
+      using namespace n447;
+
+      std::cout << factorial_table::size << ','
+                << factorial_table::at(20) << ','
+                << cumulative_sum_table::at(256) << ','
+                << binomial(10, 3) << '\n';
+
+      try
+      {
+         binomial(70, 35);
+      }
+      catch (std::overflow_error const& e)
+      {
+         std::cout << e.what() << '\n';
+      }
+
+      try
+      {
+         factorial_table::at(21);
+      }
+      catch (std::out_of_range const& e)
+      {
+         std::cout << e.what() << '\n';
+      }
+
+      std::vector<unsigned> indexes(bench ? 10'000'000 : 100'000);
+      std::mt19937 gen(42);
+      std::uniform_int_distribution<unsigned> dist(0, 12);
+      for (auto& i : indexes)
+         i = dist(gen);
+
+      measure("n410::factorial", indexes, [](unsigned i) { return n410::factorial(i); });
+      measure("factorial_table", indexes, [](unsigned i) { return factorial_table::at(i); });
+   }
+
+   {
+      using namespace n448;
+
+      int const accounts = bench ? 1'000'000 : 10'000;
+      int const transactions = bench ? 5'000'000 : 50'000;
+
+      std::mt19937 gen(42);
+      std::uniform_int_distribution<int> account_dist(0, accounts - 1);
+      std::uniform_real_distribution<double> amount_dist(-150.0, 100.0);
+
+      std::vector<transaction> batch(transactions);
+      for (auto& t : batch)
+         t = { 1'000'000 + account_dist(gen) * 7, amount_dist(gen) };
+
+      std::vector<n412::balance_t> balances;
+      std::unordered_map<int, std::size_t> rows;
+      ledger l;
+      l.reserve(accounts);
+      for (int i = 0; i < accounts; ++i)
+      {
+         n412::account_t account{ 1'000'000 + i * 7 };
+         rows.emplace(account.number, balances.size());
+         balances.push_back({ account, 100.0 });
+         l.open(account, 100.0);
+      }
+
+      auto checks = std::make_unique<bool[]>(batch.size());
+      l.can_withdraw(batch, std::span<bool>(checks.get(), batch.size()));
+      std::cout << "accepted individually: "
+                << std::count(checks.get(), checks.get() + batch.size(), true) << '\n';
+
+      auto start = std::chrono::steady_clock::now();
+      std::size_t applied = 0;
+      for (auto const& t : batch)
+      {
+         auto& b = balances[rows.at(t.account)];
+         if (t.amount >= 0)
+         {
+            b.amount += t.amount;
+            ++applied;
+         }
+         else if (b.can_withdraw(-t.amount))
+         {
+            b.withdraw(-t.amount);
+            ++applied;
+         }
+      }
+      auto end = std::chrono::steady_clock::now();
+      double seconds = std::chrono::duration<double>(end - start).count();
+      std::cout << "vector<balance_t>: " << applied << " applied, "
+                << transactions / seconds / 1e6 << " M tx/s\n";
+
+      start = std::chrono::steady_clock::now();
+      applied = l.apply_transactions(batch);
+      end = std::chrono::steady_clock::now();
+      seconds = std::chrono::duration<double>(end - start).count();
+      std::cout << "ledger: " << applied << " applied, "
+                << transactions / seconds / 1e6 << " M tx/s\n";
+   }
+
+   {
+      using namespace n449;
+
+      atomic_balance b(to_cents(100.0));
+      if (auto t = b.try_withdraw(to_cents(42.5)))
+         std::cout << t->amount << ',' << to_amount(b.get()) << '\n';
+      if (!b.try_withdraw(to_cents(60.0)))
+         std::cout << "insufficient funds\n";
+      if (!b.try_withdraw(to_cents(-500.0)) && !b.deposit(to_cents(-500.0)))
+         std::cout << "negative amounts rejected\n";
+
+      int const operations = bench ? 200'000 : 5'000;
+      stress<atomic_balance>("atomic_balance", 32, operations);
+      stress<sharded_balance<>>("sharded_balance", 32, operations);
+   }
+
+#if defined(__unix__) || defined(__APPLE__)
+   {
+      using namespace n450;
+
+      auto path = std::filesystem::temp_directory_path() / "n450_journal.bin";
+      std::filesystem::remove(path);
+      {
+         journal j(path, 1024);
+         n412::balance_t b{ { 42 }, 100.0 };
+         for (double amount : { 10.0, 25.5, 99.0 })
+            if (b.can_withdraw(amount))
+               j.wait_durable(*j.append(b.get_account_number(), b.withdraw(amount)));
+      }
+
+      std::map<int, double> balances{ { 42, 100.0 } };
+      auto count = replay(path, [&balances](int account, n412::transaction_t t) {
+         balances[account] += t.amount;
+      });
+      std::cout << "replayed " << count << ", balance " << balances[42] << '\n';
+
+      // tear the first record; the one after it is dropped on reopening
+      int fd = ::open(path.c_str(), O_WRONLY);
+      std::uint64_t const torn = 0;
+      ::pwrite(fd, &torn, sizeof(torn), offsetof(journal_record, checksum));
+      ::close(fd);
+      {
+         journal j(path, 1024);
+         j.wait_durable(*j.append(42, n412::transaction_t{ -1.0 }));
+      }
+      count = replay(path, [](int, n412::transaction_t) {});
+      std::cout << "after a torn record, replayed " << count << '\n';   // 1
+
+      for (std::size_t group : { 1, 16, 256 })
+         commit_throughput(path, group, 16, bench ? 500 : 50);
+      std::filesystem::remove(path);
+   }
+#endif
+
+   {
+      using namespace n451;
+
+      std::size_t const accounts = bench ? 10'000'000 : 100'000;
+      constexpr cents bucket_width = to_cents(1000.0);
+      balance_book<> book(accounts, bucket_width);
+
+      std::mt19937 gen(42);
+      std::uniform_int_distribution<int> account(0, accounts - 1);
+      std::uniform_real_distribution<double> amount(0.0, 5000.0);
+
+      double update = microseconds_per_call([&] {
+         book.deposit(account(gen), amount(gen));
+         book.withdraw(account(gen), amount(gen) / 4);
+      }, bench ? 1'000'000 : 10'000) / 2;
+
+      auto incremental = book.make_report();
+      auto scanned = full_scan<10, 16>(book.data(), bucket_width);
+      std::cout << "report consistent: " << std::boolalpha << (incremental == scanned)
+                << ", exposure " << to_amount(incremental.exposure)
+                << ", top account " << incremental.top[0].first << '\n';
+
+      if (!book.deposit(0, -500.0) && !book.withdraw(0, -500.0) &&
+          !book.deposit(-1, 10.0) && !book.withdraw(static_cast<int>(accounts), 10.0))
+         std::cout << "negative amounts and unknown accounts rejected\n";
+
+      cents sink = 0;
+      double snapshot = microseconds_per_call([&] { sink += book.make_report().exposure; },
+                                              bench ? 100'000 : 1'000);
+      double scan = microseconds_per_call([&] {
+         sink += full_scan<10, 16>(book.data(), bucket_width).exposure; }, 10);
+      std::cout << "update " << update << "us, snapshot " << snapshot
+                << "us, full scan " << scan << "us (" << (sink != 0) << ")\n";
+   }
+
+   {
+      using namespace n452;
+
+      std::string_view text = "1000001,12.5\n1000008,-3.25\r\n\n1000015,100\n";
+      int numbers[3];
+      double amounts[3];
+      std::size_t rows = parse_rows(text, numbers, amounts);
+      for (std::size_t i = 0; i < rows; ++i)
+         std::cout << numbers[i] << ':' << amounts[i] << '\n';
+
+      try
+      {
+         parse_rows("1000001,12.5\n10x0008,1\n", numbers, amounts);
+      }
+      catch (std::runtime_error const& e)
+      {
+         std::cout << e.what() << '\n';
+      }
+   }
+
+#if defined(__unix__) || defined(__APPLE__)
+   {
+      using namespace n452;
+
+      std::size_t const lines = bench ? 16'000'000 : 100'000;
+      auto path = std::filesystem::temp_directory_path() / "n452_accounts.csv";
+      {
+         std::mt19937 gen(42);
+         std::uniform_int_distribution<int> number(1'000'000, 99'999'999);
+         std::uniform_int_distribution<int> cents(-100'000, 10'000'000);
+         std::ofstream out(path, std::ios::binary);
+         std::vector<char> buffer(1 << 20);
+         std::size_t used = 0;
+         for (std::size_t i = 0; i < lines; ++i)
+         {
+            if (buffer.size() - used < 64)
+            {
+               out.write(buffer.data(), used);
+               used = 0;
+            }
+            char* p = buffer.data() + used;
+            p = std::to_chars(p, p + 16, number(gen)).ptr;
+            *p++ = ',';
+            p = std::to_chars(p, p + 24, cents(gen) / 100.0, std::chars_format::fixed, 2).ptr;
+            *p++ = '\n';
+            used = static_cast<std::size_t>(p - buffer.data());
+         }
+         out.write(buffer.data(), used);
+      }
+
+      {
+         mapped_file file(path);
+         double const gigabytes = file.text().size() / 1e9;
+
+         auto start = std::chrono::steady_clock::now();
+         std::size_t const rows = count_rows(file.text());
+         std::vector<int> numbers(rows);
+         std::vector<double> amounts(rows);
+         std::size_t parsed = parse_rows(file.text(), numbers, amounts);
+         auto end = std::chrono::steady_clock::now();
+         double bulk = std::chrono::duration<double>(end - start).count();
+
+         std::vector<int> numbers_by_string;
+         std::vector<double> amounts_by_string;
+         start = std::chrono::steady_clock::now();
+         parse_rows_by_string(file.text(), numbers_by_string, amounts_by_string);
+         end = std::chrono::steady_clock::now();
+         double by_string = std::chrono::duration<double>(end - start).count();
+
+         std::cout << parsed << " rows, " << gigabytes << " GB: bulk "
+                   << gigabytes / bulk << " GB/s, from_string "
+                   << gigabytes / by_string << " GB/s, same result "
+                   << std::boolalpha
+                   << (numbers == numbers_by_string && amounts == amounts_by_string) << '\n';
+
+         std::size_t const opened = std::min<std::size_t>(parsed, 1'000'000);
+         n448::ledger l;
+         l.reserve(opened);
+         l.open_all(std::span(numbers).first(opened), std::span(amounts).first(opened));
+         std::cout << "opened " << l.size() << " accounts\n";
+      }
+      std::filesystem::remove(path);
+   }
+#endif
+
+   {
+      using namespace n453;
+      using n412::account_t;
+      using n412::balance_t;
+
+      std::vector<balance_t> balances{ { { 3 }, 20.0 }, { { 1 }, -5.0 },
+                                       { { 3 }, 7.5 },  { { 2 }, 20.0 },
+                                       { { 4 }, 0.0 },  { { 5 }, -0.0 } };
+      sort_by<&balance_t::amount>(balances);   // 4:0 stays ahead of 5:-0
+      for (auto const& b : balances)
+         std::cout << b.account.number << ':' << b.amount << ' ';
+      std::cout << '\n';
+
+      for (auto group : group_by<&balance_t::account, &account_t::number>(balances))
+         std::cout << group.begin()->account.number << " x" << group.size() << ' ';
+      std::cout << '\n';
+
+      std::vector<account_t> accounts{ { 42 }, { 7 }, { 42 } };
+      auto index = index_by<&account_t::number>(accounts);
+      std::cout << index.size() << " numbers, 42 first at " << index[42] << '\n';
+
+      std::size_t const count = bench ? 5'000'000 : 50'000;
+      std::mt19937 gen(42);
+      std::uniform_int_distribution<int> number(0, 1'000'000);
+      std::uniform_real_distribution<double> amount(-1000.0, 1000.0);
+      std::vector<balance_t> data(count);
+      for (auto& b : data)
+         b = { { number(gen) }, amount(gen) };
+
+      auto time = [&data](auto sort) {
+         auto copy = data;
+         auto start = std::chrono::steady_clock::now();
+         sort(copy);
+         auto end = std::chrono::steady_clock::now();
+         return std::make_pair(std::chrono::duration<double, std::milli>(end - start).count(),
+                               std::move(copy));
+      };
+
+      auto [radix_ms, by_radix] = time([](auto& v) { sort_by<&balance_t::amount>(v); });
+      auto [sort_ms, by_sort] = time([](auto& v) { std::ranges::sort(v, {}, &balance_t::amount); });
+      auto [stable_ms, by_stable] = time([](auto& v) {
+         std::ranges::stable_sort(v, {}, &balance_t::amount); });
+      auto [number_ms, by_number] = time([](auto& v) {
+         sort_by<&balance_t::account, &account_t::number>(v); });
+
+      std::cout << "sort_by amount " << radix_ms << "ms, ranges::sort " << sort_ms
+                << "ms, ranges::stable_sort " << stable_ms << "ms, sort_by number "
+                << number_ms << "ms, same order " << std::boolalpha
+                << std::ranges::equal(by_radix, by_stable, {}, &balance_t::amount,
+                                      &balance_t::amount) << '\n';
+   }
+
+   {
+      using namespace n454;
+
+      arena a;
+      {
+         use_resource scope(a);
+         auto v = n418::make_vector<resource_allocator>(1, 2, 3);
+         n420::range_t r(v.begin(), v.end(), resource_allocator<int>());
+         std::pmr::vector<int> p({ 4, 5, 6 }, &a);
+         static_assert(std::is_same_v<decltype(r),
+            n420::range_t<int, n420::ownership::owned, resource_allocator<int>>>);
+         std::cout << v.size() + r.size() + p.size() << " elements in the arena\n";
+      }
+
+      int const requests = bench ? 20'000 : 2'000;
+      counting_resource counter;
+      {
+         use_resource scope(counter);
+         measure("heap", counter, requests, [] {});
+      }
+      {
+         pool p(&counter);
+         use_resource scope(p);
+         measure("pool", counter, requests, [] {});
+      }
+      {
+         arena per_request(4096, &counter);
+         use_resource scope(per_request);
+         measure("arena", counter, requests, [&per_request] { per_request.reset(); });
+      }
+   }
+
+#if defined(__unix__) || defined(__APPLE__)
+   {
+      using namespace n455;
+
+      echo_server server;
+      endpoint const local = server.where();
+      {
+         connection_pool<echo_client> pool({ local }, 4);
+         {
+            auto a = pool.checkout(local);
+            auto b = pool.checkout(local);
+            std::cout << echo_client::call(*a, "hello") << ' '
+                      << pool.open_connections(local) << " open\n";
+         }
+         auto c = pool.checkout(local);   // reuses one of the two
+         std::cout << pool.open_connections(local) << " open, "
+                   << pool.evict_idle(std::chrono::seconds(0)) << " evicted, "
+                   << pool.open_connections(local) << " open\n";
+
+         std::string const message(64, 'x');
+         measure_latency("pooled", 2000, [&] {
+            auto l = pool.checkout(local);
+            echo_client::call(*l, message);
+         });
+         measure_latency("unpooled", 2000, [&] { echo_client::call(local, message); });
+      }
+   }
+#endif
+}
\ No newline at end of file